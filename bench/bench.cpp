@@ -0,0 +1,639 @@
+#include "../include/VehicleManager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace bk;
+
+/*
+ * Benchmarks of the VehicleManager indexes, loaders and searches against
+ * the implementations they replaced.
+ *
+ * Usage: bench [vehicles] [section...]
+ *   vehicles  Fleet size (default 200000).
+ *   section   One of the names in the sections table (default: all).
+ *
+ * Build with optimizations (e.g. -DCMAKE_BUILD_TYPE=Release) for meaningful numbers.
+ */
+
+namespace {
+std::atomic<std::size_t> allocationCount{0}; // Calls to the global operator new
+}
+
+// Count every heap allocation of the program
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Run a function once and return the elapsed time in seconds.
+ */
+template <typename F>
+double timeIt(F&& f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Run a function once and return the number of heap allocations it made.
+ */
+template <typename F>
+std::size_t countAllocations(F&& f) {
+    std::size_t before = allocationCount.load();
+    f();
+    return allocationCount.load() - before;
+}
+
+/**
+ * @brief Registration number of the i-th generated vehicle (at most 9 characters).
+ */
+std::string regOf(std::size_t i) {
+    std::string digits = std::to_string(i);
+    return "BK" + std::string(7 - std::min<std::size_t>(7, digits.size()), '0') + digits;
+}
+
+/**
+ * @brief Generate the i-th vehicle of a mixed fleet.
+ */
+Vehicle* makeVehicle(std::size_t i) {
+    static const char* const brands[] = {"Toyota", "Skoda", "Ford", "Kia", "Tesla", "Volvo", "Honda", "Audi"};
+    using Fuel = CombustionVehicle::FuelType;
+    using Licence = Vehicle::LicenceCategory;
+    std::string reg = regOf(i);
+    std::string brand = brands[i % 8];
+    double mileage = 1000.0 + static_cast<double>(i % 9000);
+    double cost = 100.0 + static_cast<double>(i % 400);
+    switch (i % 4) {
+        case 0: return new CombustionCar(reg, brand, "Model", mileage, cost, Licence::B, 1500, 6.0, Fuel::Gasoline, 5);
+        case 1: return new ElectricCar(reg, brand, "Model", mileage, cost, Licence::B, 60.0, 5);
+        case 2: return new Truck(reg, brand, "Model", mileage, cost, Licence::C, 12000, 25.0, Fuel::Diesel, 20000);
+        default: return new Motorcycle(reg, brand, "Model", mileage, cost, Licence::A, 650, 4.5, Fuel::Gasoline);
+    }
+}
+
+/**
+ * @brief Add vehicles 0..n-1 to a manager.
+ */
+void addFleet(VehicleManager& vm, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) vm.addVehicle(makeVehicle(i));
+}
+
+/**
+ * @brief ID card number of the i-th generated customer.
+ */
+std::string customerIdOf(std::size_t i) {
+    std::string digits = std::to_string(i);
+    return "CUS" + std::string(7 - std::min<std::size_t>(7, digits.size()), '0') + digits;
+}
+
+/**
+ * @brief Add customers 0..n-1 to a manager (names and addresses too long for the small string buffer).
+ */
+void addCustomers(VehicleManager& vm, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string id = customerIdOf(i);
+        vm.addCustomer(new PrivateCustomer("Customer Name " + id, "Street of Customer " + id, id));
+    }
+}
+
+/**
+ * @brief Rent and return vehicles 0..n-1 once each, so that the history holds n records.
+ * @param customers Number of customers added with addCustomers.
+ */
+void addHistory(VehicleManager& vm, std::size_t n, std::size_t customers) {
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string reg = regOf(i);
+        vm.rentVehicle(reg, customerIdOf(i % customers), "2025-01-01", "2025-01-05", false);
+        vm.returnVehicle(reg, vm.getVehicle(reg)->getMileage() + 100.0);
+    }
+}
+
+/**
+ * @brief Build a manager with a fleet of n, n/4 customers, n/2 history records and
+ * n/8 active rentals.
+ * @return Number of records (vehicles, customers, rentals and history).
+ */
+std::size_t buildDataSet(VehicleManager& vm, std::size_t n) {
+    std::size_t customers = std::max<std::size_t>(1, n / 4);
+    addFleet(vm, n);
+    addCustomers(vm, customers);
+    addHistory(vm, n / 2, customers);
+    for (std::size_t i = n / 2; i < n / 2 + n / 8; ++i) {
+        vm.rentVehicle(regOf(i), customerIdOf(i % customers), "2025-02-01", "2025-02-10", false);
+    }
+    return n + customers + n / 2 + n / 8;
+}
+
+/**
+ * @brief Path of a scratch file in the system's temporary directory.
+ */
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * @brief Print the throughput of one load or save.
+ */
+void reportRate(const char* what, std::size_t records, double seconds) {
+    std::cout << "          " << std::left << std::setw(28) << what << std::right << std::setw(10)
+              << seconds * 1e3 << " ms " << std::setw(12) << static_cast<long long>(static_cast<double>(records) / seconds)
+              << " records/s\n";
+}
+
+/**
+ * @brief Registration numbers of vehicles 0..n-1 in random order.
+ */
+std::vector<std::string> shuffledRegs(std::size_t n) {
+    std::vector<std::string> regs;
+    regs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) regs.push_back(regOf(i));
+    std::shuffle(regs.begin(), regs.end(), std::mt19937(42));
+    return regs;
+}
+
+/**
+ * @brief Registration number index (user-001) against the linear scan it replaced.
+ */
+void benchLookup(std::size_t n) {
+    VehicleManager vm;
+    double addSeconds = timeIt([&] { addFleet(vm, n); });
+    std::vector<std::string> regs = shuffledRegs(n);
+
+    // The scan getVehicle used to do, copying every registration number it compared
+    std::vector<const Vehicle*> fleet;
+    fleet.reserve(n);
+    for (std::size_t slot = 0; slot < n; ++slot) fleet.push_back(vm.getVehicleBySlot(slot));
+    std::size_t scanQueries = std::min<std::size_t>(n, 2000);
+    std::size_t scanFound = 0;
+    double scanSeconds = timeIt([&] {
+        for (std::size_t q = 0; q < scanQueries; ++q) {
+            for (const Vehicle* v : fleet) {
+                if (std::string(v->getRegNumber()) == regs[q]) {
+                    ++scanFound;
+                    break;
+                }
+            }
+        }
+    });
+
+    std::size_t indexFound = 0;
+    double indexSeconds = timeIt([&] {
+        for (const auto& reg : regs) indexFound += vm.getVehicle(reg) != nullptr;
+    });
+
+    double scanNs = scanSeconds * 1e9 / static_cast<double>(scanQueries);
+    double indexNs = indexSeconds * 1e9 / static_cast<double>(n);
+    std::cout << "lookup:   " << n << " vehicles added in " << addSeconds * 1e3 << " ms (uniqueness checked by the index)\n"
+              << "          scan  " << scanNs << " ns/lookup (" << scanFound << "/" << scanQueries << " found)\n"
+              << "          index " << indexNs << " ns/lookup (" << indexFound << "/" << n << " found), "
+              << scanNs / indexNs << "x faster\n";
+}
+
+/**
+ * @brief Column filter kernels against a scan over the vehicle objects (user-008).
+ */
+void benchFilter(std::size_t n) {
+    VehicleManager vm;
+    addFleet(vm, n);
+    std::vector<const Vehicle*> fleet;
+    fleet.reserve(n);
+    for (std::size_t slot = 0; slot < n; ++slot) fleet.push_back(vm.getVehicleBySlot(slot));
+    VehicleFilter filter;
+    filter.where(VehicleFilter::Column::BaseCost, VehicleFilter::Op::LessEqual, 300)
+          .where(VehicleFilter::Column::Mileage, VehicleFilter::Op::Less, 5000)
+          .licence(Vehicle::LicenceCategory::B);
+    const int repeats = 20;
+
+    std::size_t objectMatches = 0;
+    double objectSeconds = timeIt([&] {
+        for (int r = 0; r < repeats; ++r) {
+            for (const Vehicle* v : fleet) {
+                objectMatches += v->getBaseCost() <= 300 && v->getMileage() < 5000 &&
+                                 v->getLicenceCategory() == Vehicle::LicenceCategory::B;
+            }
+        }
+    });
+    auto perScan = [&](double seconds) { return seconds * 1e3 / repeats; };
+    std::cout << "filter:   3 predicates over " << n << " vehicles\n"
+              << "          " << std::left << std::setw(16) << "object scan" << std::right << std::setw(10)
+              << perScan(objectSeconds) << " ms (" << objectMatches / repeats << " matches)\n";
+
+    const char* names[] = {"scalar columns", "SSE2 columns", "AVX2 columns"};
+    auto best = VehicleFilter::detectSimdLevel();
+    for (int level = 0; level <= static_cast<int>(best); ++level) {
+        std::size_t matches = 0;
+        double seconds = timeIt([&] {
+            for (int r = 0; r < repeats; ++r) {
+                matches += filter.evaluate(vm.getColumns(), static_cast<VehicleFilter::SimdLevel>(level)).count();
+            }
+        });
+        std::cout << "          " << std::left << std::setw(16) << names[level] << std::right << std::setw(10)
+                  << perScan(seconds) << " ms (" << matches / repeats << " matches), speedup "
+                  << objectSeconds / seconds << "x\n";
+    }
+}
+
+/**
+ * @brief Heap allocations of the string_view accessors on the search paths (user-005).
+ */
+void benchAllocations(std::size_t n) {
+    VehicleManager vm;
+    addFleet(vm, n);
+    addCustomers(vm, n);
+    std::vector<std::string> regs = shuffledRegs(n);
+    std::vector<std::string> ids;
+    ids.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) ids.push_back(customerIdOf(i));
+
+    std::size_t found = 0;
+    std::size_t vehicleLookups = countAllocations([&] {
+        for (const auto& reg : regs) found += vm.getVehicle(reg) != nullptr;
+    });
+    std::size_t customerLookups = countAllocations([&] {
+        for (const auto& id : ids) found += vm.getCustomer(id) != nullptr;
+    });
+    std::size_t brandMatches = 0;
+    std::size_t brandSearch = countAllocations([&] { brandMatches = vm.findVehiclesByBrand("Toyota").size(); });
+    VehicleQuery query;
+    query.withModel("Model").priceBetween(0, 300); // compares the model of every vehicle under the price
+    std::size_t filtered = 0;
+    std::size_t modelScan = countAllocations([&] {
+        vm.forEachVehicle(query, [&](const Vehicle*) { ++filtered; });
+    });
+
+    // What a search comparing copies of the names (the old by-value getters) allocates
+    std::vector<const Customer*> customers;
+    customers.reserve(n);
+    for (const auto& id : ids) customers.push_back(vm.getCustomer(id));
+    std::size_t copying = countAllocations([&] {
+        for (const Customer* c : customers) found += std::string(c->getName()) == "Customer Name CUS0000000";
+    });
+
+    double perComparison = static_cast<double>(copying) / static_cast<double>(n);
+    std::cout << "alloc:    " << n << " vehicles, " << n << " customers (" << found << " hits)\n"
+              << "          getVehicle x" << n << ": " << vehicleLookups << " allocations\n"
+              << "          getCustomer x" << n << ": " << customerLookups << " allocations\n"
+              << "          findVehiclesByBrand: " << brandSearch << " allocations for " << brandMatches
+              << " matches (the result vector)\n"
+              << "          forEachVehicle(model, price): " << modelScan << " allocations for " << filtered
+              << " matches\n"
+              << "          comparing name copies: " << copying << " allocations, " << perComparison
+              << " per comparison\n";
+}
+
+/**
+ * @brief Load and save throughput of the text format and the binary snapshot (user-011).
+ */
+void benchSnapshot(std::size_t n) {
+    VehicleManager vm;
+    std::size_t records = buildDataSet(vm, n);
+    std::string textFile = tempPath("bench_data.txt");
+    std::string snapshotFile = tempPath("bench_data.bin");
+
+    std::cout << "snapshot: " << records << " records (" << n << " vehicles)\n";
+    reportRate("text save", records, timeIt([&] { vm.saveToFile(textFile); }));
+    reportRate("snapshot save", records, timeIt([&] { vm.saveSnapshot(snapshotFile); }));
+    {
+        VehicleManager loaded;
+        reportRate("text load (1 thread)", records, timeIt([&] { loaded.loadFromFile(textFile, 1); }));
+    }
+    {
+        VehicleManager loaded;
+        reportRate("text load (all threads)", records, timeIt([&] { loaded.loadFromFile(textFile); }));
+    }
+    {
+        VehicleManager loaded;
+        reportRate("snapshot load", records, timeIt([&] { loaded.loadSnapshot(snapshotFile); }));
+    }
+    std::remove(textFile.c_str());
+    std::remove(snapshotFile.c_str());
+}
+
+/**
+ * @brief Mapped snapshot with lazily built objects against the eager snapshot load (user-012).
+ * Measured on the full data set and on the fleet and customers alone, the part mapping defers.
+ */
+void benchMappedSnapshot(std::size_t n) {
+    std::string fullFile = tempPath("bench_map.bin");
+    std::string fleetFile = tempPath("bench_map_fleet.bin");
+    std::size_t records = 0;
+    {
+        VehicleManager vm;
+        records = buildDataSet(vm, n);
+        vm.saveSnapshot(fullFile);
+    }
+    {
+        VehicleManager vm;
+        addFleet(vm, n);
+        addCustomers(vm, n / 4);
+        vm.saveSnapshot(fleetFile);
+    }
+    std::vector<std::string> regs = shuffledRegs(std::min<std::size_t>(n, 1000));
+
+    auto compare = [&](const std::string& file) {
+        for (int mapped = 0; mapped < 2; ++mapped) {
+            VehicleManager vm;
+            double seconds = 0.0;
+            std::size_t allocations = countAllocations([&] {
+                seconds = timeIt([&] { mapped ? vm.mapSnapshot(file) : vm.loadSnapshot(file); });
+            });
+            std::size_t found = 0;
+            double firstAccess = timeIt([&] {
+                for (const auto& reg : regs) found += vm.getVehicle(reg) != nullptr;
+            });
+            std::cout << "          " << (mapped ? "mapSnapshot " : "loadSnapshot") << std::setw(10)
+                      << seconds * 1e3 << " ms, " << std::setw(9) << allocations << " allocations; first access to "
+                      << found << " vehicles " << firstAccess * 1e6 / static_cast<double>(regs.size()) << " us each\n";
+        }
+    };
+    std::cout << "map:      " << records << " records (" << n << " vehicles)\n";
+    compare(fullFile);
+    std::cout << "          " << n + n / 4 << " records (fleet and customers only)\n";
+    compare(fleetFile);
+    std::remove(fullFile.c_str());
+    std::remove(fleetFile.c_str());
+}
+
+/**
+ * @brief Write a data file of n vehicle lines of every kind and no other records.
+ */
+void writeVehicleFile(const std::string& filename, std::size_t n) {
+    std::ofstream out(filename);
+    out << n << "\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string reg = regOf(i);
+        int cost = 100 + static_cast<int>(i % 400);
+        int mileage = 1000 + static_cast<int>(i % 9000);
+        switch (i % 4) {
+            case 0: out << "CombustionCar;Toyota;Yaris;" << reg << ";" << cost << ";1496;5.5;0;1;" << mileage << ";5\n"; break;
+            case 1: out << "ElectricCar;Tesla;Model 3;" << reg << ";" << cost << ";75.5;1;" << mileage << ".5;4\n"; break;
+            case 2: out << "Truck;Volvo;FH;" << reg << ";" << cost << ";12777;25.5;1;2;" << mileage << ";20000\n"; break;
+            default: out << "Motorcycle;Yamaha;MT-07;" << reg << ";" << cost << ";689;4.2;0;0;" << mileage << "\n"; break;
+        }
+    }
+    out << "0\n0\n0\n0\n";
+}
+
+/**
+ * @brief The vehicle section parser loadFromFile had before TextReader: a stringstream and
+ * a vector of strings per line and std::stoi/std::stod per field.
+ */
+std::vector<Vehicle*> legacyLoadVehicles(const std::string& filename) {
+    using Fuel = CombustionVehicle::FuelType;
+    using Licence = Vehicle::LicenceCategory;
+    std::vector<Vehicle*> vehicles;
+    std::ifstream file(filename);
+    std::string line;
+    int vCount = 0;
+    if (std::getline(file, line)) vCount = std::stoi(line);
+    for (int i = 0; i < vCount; ++i) {
+        if (!std::getline(file, line)) break;
+        std::stringstream ss(line);
+        std::string segment;
+        std::vector<std::string> parts;
+        while (std::getline(ss, segment, ';')) parts.push_back(segment);
+        if (parts.empty()) continue;
+
+        if (parts[0] == "CombustionCar" && parts.size() >= 11) {
+            vehicles.push_back(new CombustionCar(parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]),
+                static_cast<Licence>(std::stoi(parts[8])), std::stoi(parts[5]), std::stod(parts[6]),
+                static_cast<Fuel>(std::stoi(parts[7])), std::stoi(parts[10])));
+        } else if (parts[0] == "ElectricCar" && parts.size() >= 9) {
+            vehicles.push_back(new ElectricCar(parts[3], parts[1], parts[2], std::stod(parts[7]), std::stod(parts[4]),
+                static_cast<Licence>(std::stoi(parts[6])), std::stod(parts[5]), std::stoi(parts[8])));
+        } else if (parts[0] == "Truck" && parts.size() >= 11) {
+            vehicles.push_back(new Truck(parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]),
+                static_cast<Licence>(std::stoi(parts[8])), std::stoi(parts[5]), std::stod(parts[6]),
+                static_cast<Fuel>(std::stoi(parts[7])), std::stoi(parts[10])));
+        } else if (parts[0] == "Motorcycle" && parts.size() >= 10) {
+            vehicles.push_back(new Motorcycle(parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]),
+                static_cast<Licence>(std::stoi(parts[8])), std::stoi(parts[5]), std::stod(parts[6]),
+                static_cast<Fuel>(std::stoi(parts[7]))));
+        }
+    }
+    return vehicles;
+}
+
+/**
+ * @brief In-place TextReader parsing against the stringstream parser it replaced (user-013).
+ * The file has five lines per fleet vehicle (1M lines for the default fleet). Both loaders
+ * add the parsed vehicles to a manager, so the indexing cost is the same on both sides.
+ */
+void benchParse(std::size_t n) {
+    std::size_t lines = std::min<std::size_t>(5 * n, 9999999);
+    std::string textFile = tempPath("bench_parse.txt");
+    writeVehicleFile(textFile, lines);
+
+    auto run = [&](const char* what, auto&& load) {
+        VehicleManager vm;
+        double seconds = 0.0;
+        std::size_t allocations = countAllocations([&] { seconds = timeIt([&] { load(vm); }); });
+        std::cout << "          " << std::left << std::setw(28) << what << std::right << std::setw(10)
+                  << seconds * 1e3 << " ms " << std::setw(12)
+                  << static_cast<long long>(static_cast<double>(lines) / seconds) << " lines/s "
+                  << static_cast<double>(allocations) / static_cast<double>(lines) << " allocations/line ("
+                  << vm.getColumns().size() << " loaded)\n";
+    };
+    std::cout << "parse:    " << lines << " vehicle lines\n";
+    run("stringstream parser", [&](VehicleManager& vm) {
+        for (Vehicle* v : legacyLoadVehicles(textFile)) vm.addVehicle(v);
+    });
+    run("loadFromFile (1 thread)", [&](VehicleManager& vm) { vm.loadFromFile(textFile, 1); });
+    run("loadFromFile (all threads)", [&](VehicleManager& vm) { vm.loadFromFile(textFile); });
+    std::remove(textFile.c_str());
+}
+
+/**
+ * @brief Days in a month as Rental computed them before Date (1-based month).
+ */
+int legacyDaysInMonth(int month, int year) {
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+    return days[month - 1] + (month == 2 && leap);
+}
+
+/**
+ * @brief Rental::countTotalDays before Date: a loop over every year and month before the date.
+ */
+int legacyCountTotalDays(const std::string& date) {
+    int y = std::stoi(date.substr(0, 4));
+    int m = std::stoi(date.substr(5, 2));
+    int total = std::stoi(date.substr(8, 2));
+    for (int i = 1; i < y; ++i) total += legacyDaysInMonth(2, i) == 29 ? 366 : 365;
+    for (int i = 1; i < m; ++i) total += legacyDaysInMonth(i, y);
+    return total;
+}
+
+/**
+ * @brief Closed-form day numbers against the per-date year loop they replaced (user-020).
+ * Prices five rentals per fleet vehicle (1M for the default fleet) both ways.
+ */
+void benchDates(std::size_t n) {
+    std::size_t count = 5 * n;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> startDay(Date::toDayNumber(2000, 1, 1), Date::toDayNumber(2030, 12, 31));
+    std::uniform_int_distribution<int> length(1, 30);
+    std::vector<std::pair<std::string, std::string>> periods;
+    periods.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int start = startDay(rng);
+        periods.emplace_back(Date::toString(start), Date::toString(start + length(rng)));
+    }
+    CombustionCar car("BK0000000", "Toyota", "Yaris", 1000, 120, Vehicle::LicenceCategory::B, 1496, 5.5,
+                      CombustionVehicle::FuelType::Gasoline, 5);
+    PrivateCustomer customer("Jan Kowalski", "Warszawa", "ABC123456");
+
+    // Each getRentalDays() counted both dates from year 1
+    double legacyTotal = 0.0;
+    double legacySeconds = timeIt([&] {
+        for (const auto& p : periods) {
+            int days = legacyCountTotalDays(p.second) - legacyCountTotalDays(p.first);
+            legacyTotal += car.calculateRentCost(days < 1 ? 1 : days);
+        }
+    });
+
+    std::vector<Rental> rentals;
+    rentals.reserve(count);
+    double parseSeconds = timeIt([&] {
+        for (const auto& p : periods) rentals.emplace_back(&car, &customer, p.first, p.second);
+    });
+    double total = 0.0;
+    double costSeconds = timeIt([&] {
+        for (const auto& r : rentals) total += r.calculateTotalCost();
+    });
+
+    auto perRental = [&](double seconds) { return seconds * 1e9 / static_cast<double>(count); };
+    std::cout << "dates:    " << count << " rentals (totals " << (total == legacyTotal ? "match" : "DIFFER") << ")\n"
+              << "          year loop        " << std::setw(10) << perRental(legacySeconds) << " ns/rental\n"
+              << "          parse once       " << std::setw(10) << perRental(parseSeconds)
+              << " ns/rental (Rental constructor)\n"
+              << "          cost from days   " << std::setw(10) << perRental(costSeconds) << " ns/rental, "
+              << legacySeconds / costSeconds << "x faster\n";
+}
+
+/**
+ * @brief Batch window search against one findVehiclesFreeDuring scan per query (user-022).
+ * The fleet has a rental on every eighth vehicle and a reservation on every fourth.
+ */
+void benchSweep(std::size_t n) {
+    VehicleManager vm;
+    addFleet(vm, n);
+    std::size_t customers = std::max<std::size_t>(1, n / 4);
+    addCustomers(vm, customers);
+    for (std::size_t i = 0; i < n; i += 8) {
+        vm.rentVehicle(regOf(i), customerIdOf(i % customers), "2026-11-01", "2026-11-20", false);
+    }
+    for (std::size_t i = 2; i < n; i += 4) {
+        std::string start = Date::toString(Date::toDayNumber(2026, 11, 1) + static_cast<int>(i % 90));
+        std::string end = Date::toString(Date::toDayNumber(start) + 7);
+        vm.reserveVehicle(regOf(i), customerIdOf(i % customers), start, end);
+    }
+
+    std::size_t queryCount = 500;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> startDay(Date::toDayNumber(2026, 11, 1), Date::toDayNumber(2027, 1, 31));
+    std::uniform_int_distribution<int> length(1, 14);
+    std::uniform_int_distribution<int> pick(-1, 3);
+    std::vector<WindowQuery> queries(queryCount);
+    for (auto& q : queries) {
+        q.startDay = startDay(rng);
+        q.endDay = q.startDay + length(rng);
+        int kind = pick(rng), licence = pick(rng);
+        if (kind >= 0) q.kind = static_cast<Vehicle::VehicleKind>(kind);
+        if (licence >= 0 && licence <= 2) q.licence = static_cast<Vehicle::LicenceCategory>(licence);
+    }
+
+    std::size_t scanMatches = 0;
+    double scanSeconds = timeIt([&] {
+        for (const auto& q : queries) {
+            for (const Vehicle* v : vm.findVehiclesFreeDuring(Date::toString(q.startDay), Date::toString(q.endDay))) {
+                scanMatches += (!q.kind || v->getKind() == *q.kind) && (!q.licence || v->getLicenceCategory() == *q.licence);
+            }
+        }
+    });
+    std::size_t sweepMatches = 0;
+    double sweepSeconds = timeIt([&] {
+        for (const auto& free : vm.findVehiclesFreeDuring(queries)) sweepMatches += free.count();
+    });
+
+    std::cout << "sweep:    " << queryCount << " window queries over " << n << " vehicles ("
+              << (scanMatches == sweepMatches ? "results match" : "results DIFFER") << ")\n"
+              << "          one scan per query " << std::setw(10) << scanSeconds * 1e3 << " ms\n"
+              << "          one sweep          " << std::setw(10) << sweepSeconds * 1e3 << " ms, "
+              << scanSeconds / sweepSeconds << "x faster\n";
+}
+
+/**
+ * @struct Section
+ * @brief A named benchmark run with the fleet size.
+ */
+struct Section {
+    const char* name;
+    void (*run)(std::size_t vehicles);
+};
+
+const Section sections[] = {
+    {"lookup", benchLookup},
+    {"filter", benchFilter},
+    {"alloc", benchAllocations},
+    {"snapshot", benchSnapshot},
+    {"map", benchMappedSnapshot},
+    {"parse", benchParse},
+    {"dates", benchDates},
+    {"sweep", benchSweep},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t vehicles = 200000;
+    int first = 1;
+    if (argc > 1 && std::strspn(argv[1], "0123456789") == std::strlen(argv[1])) {
+        vehicles = std::strtoull(argv[1], nullptr, 10);
+        first = 2;
+    }
+    if (vehicles == 0 || vehicles > 9999999) {
+        std::cerr << "Fleet size must be between 1 and 9999999.\n";
+        return 1;
+    }
+
+    for (int i = first; i < argc; ++i) {
+        bool known = false;
+        for (const auto& section : sections) known = known || std::strcmp(argv[i], section.name) == 0;
+        if (!known) {
+            std::cerr << "Unknown section: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+#ifndef NDEBUG
+    std::cout << "(built without NDEBUG; configure with -DCMAKE_BUILD_TYPE=Release for meaningful numbers)\n";
+#endif
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& section : sections) {
+        bool selected = first >= argc;
+        for (int i = first; i < argc; ++i) selected = selected || std::strcmp(argv[i], section.name) == 0;
+        if (selected) section.run(vehicles);
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "Bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @brief A "which vehicles are free for the whole period" question.
+ *
+ * The period is [startDay, endDay) in Date day numbers, like a rental or
+ * reservation. Optional kind and licence restrict the vehicles considered.
+ */
+struct WindowQuery {
+    std::int32_t startDay = 0;
+    std::int32_t endDay = 0;
+    std::optional<Vehicle::VehicleKind> kind;
+    std::optional<Vehicle::LicenceCategory> licence;
+};
+
+/**
+ * @class AvailabilitySweep
+ * @brief Answers a batch of window queries in one sweep over busy periods.
+ *
+ * A vehicle is busy for [s, e) if one of its periods starts before e and
+ * ends after s, i.e. if the latest end among its periods starting before e
+ * is after s. Queries are sorted by end day and periods by start day; the
+ * sweep adds the periods starting before each query's end and keeps every
+ * vehicle's latest end in an ordered set. The busy vehicles of a query are
+ * then the set entries ending after its start, found without looking at
+ * any other vehicle or period.
+ *
+ * Cost: O((P + Q) log P) for P periods and Q queries, plus one bitmap copy
+ * and the busy vehicles per query.
+ */
+class AvailabilitySweep {
+public:
+    /**
+     * @brief A period during which a vehicle slot is taken.
+     */
+    struct Period {
+        std::int32_t startDay = 0;
+        std::int32_t endDay = 0;
+        std::size_t slot = 0;
+    };
+
+    /**
+     * @brief Run the queries.
+     * @param busy Busy periods of all slots (reordered in place).
+     * @param queries Questions to answer.
+     * @param candidates Called as candidates(query), returns the bitmap of slots the query considers.
+     * @return One bitmap per query, in query order: its candidates that are free for the whole period.
+     */
+    template <typename Candidates>
+    static std::vector<Bitset> run(std::vector<Period>& busy, const std::vector<WindowQuery>& queries,
+                                   Candidates&& candidates) {
+        std::sort(busy.begin(), busy.end(), [](const Period& a, const Period& b) { return a.startDay < b.startDay; });
+        std::vector<std::size_t> order(queries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&](std::size_t a, std::size_t b) { return queries[a].endDay < queries[b].endDay; });
+
+        std::vector<std::int32_t> latestEnd;              // Slot -> latest end added so far
+        std::set<std::pair<std::int32_t, std::size_t>> byEnd; // (latest end, slot) of slots with periods
+        std::vector<Bitset> results(queries.size());
+        std::size_t next = 0;
+        for (std::size_t q : order) {
+            const WindowQuery& query = queries[q];
+            for (; next < busy.size() && busy[next].startDay < query.endDay; ++next) {
+                const Period& p = busy[next];
+                if (p.slot >= latestEnd.size()) latestEnd.resize(p.slot + 1, std::numeric_limits<std::int32_t>::min());
+                std::int32_t& end = latestEnd[p.slot];
+                if (p.endDay <= end) continue;
+                byEnd.erase({end, p.slot});
+                end = p.endDay;
+                byEnd.emplace(end, p.slot);
+            }
+
+            Bitset free = candidates(query);
+            auto first = byEnd.upper_bound({query.startDay, std::numeric_limits<std::size_t>::max()});
+            for (auto it = first; it != byEnd.end(); ++it) {
+                if (it->second < free.size()) free.reset(it->second);
+            }
+            results[q] = std::move(free);
+        }
+        return results;
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace bk {
+
+/**
+ * @class Bitset
+ * @brief Growable bitset stored in 64-bit words.
+ *
+ * Counting and iteration work a word at a time, so their cost depends on the
+ * number of words and set bits, not on how the bits were changed.
+ */
+class Bitset {
+private:
+    std::vector<std::uint64_t> words; ///< Bit storage, bit i lives in words[i / 64]
+    std::size_t bits = 0;             ///< Logical size in bits
+
+public:
+    /**
+     * @brief Number of set bits in a word.
+     */
+    static int popcount(std::uint64_t w) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(w));
+#elif defined(__GNUC__)
+        return __builtin_popcountll(w);
+#else
+        w = w - ((w >> 1) & 0x5555555555555555ull);
+        w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+        w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((w * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    /**
+     * @brief Index of the lowest set bit in a non-zero word.
+     */
+    static int lowestBit(std::uint64_t w) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long idx;
+        _BitScanForward64(&idx, w);
+        return static_cast<int>(idx);
+#elif defined(__GNUC__)
+        return __builtin_ctzll(w);
+#else
+        return popcount((w & (0 - w)) - 1);
+#endif
+    }
+
+    /**
+     * @brief Change the logical size. New bits are cleared.
+     */
+    void resize(std::size_t n) {
+        words.resize((n + 63) / 64, 0);
+        // Clear bits past the new end of the last word
+        if (n % 64 != 0) words.back() &= (std::uint64_t{1} << (n % 64)) - 1;
+        bits = n;
+    }
+
+    std::size_t size() const { return bits; }
+
+    void set(std::size_t i) { words[i / 64] |= std::uint64_t{1} << (i % 64); }
+    void reset(std::size_t i) { words[i / 64] &= ~(std::uint64_t{1} << (i % 64)); }
+    bool test(std::size_t i) const { return (words[i / 64] >> (i % 64)) & 1u; }
+
+    /**
+     * @brief Set every bit in [0, size()).
+     */
+    void setAll() {
+        for (auto& w : words) w = ~std::uint64_t{0};
+        if (bits % 64 != 0) words.back() = (std::uint64_t{1} << (bits % 64)) - 1;
+    }
+
+    /**
+     * @brief Keep only bits that are also set in other (sizes must match).
+     */
+    Bitset& operator&=(const Bitset& other) {
+        for (std::size_t i = 0; i < words.size(); ++i) words[i] &= other.words[i];
+        return *this;
+    }
+
+    /**
+     * @brief Clear all bits and set the size to 0.
+     */
+    void clear() {
+        words.clear();
+        bits = 0;
+    }
+
+    /**
+     * @brief Number of set bits.
+     */
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (std::uint64_t w : words) total += popcount(w);
+        return total;
+    }
+
+    /**
+     * @brief Call f(index) for every set bit in ascending order.
+     */
+    template <typename F>
+    void forEachSet(F&& f) const {
+        for (std::size_t wi = 0; wi < words.size(); ++wi) {
+            std::uint64_t w = words[wi];
+            while (w) {
+                f(wi * 64 + lowestBit(w));
+                w &= w - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Call f(index) for set bits in ascending order until f returns false.
+     * @return false if the iteration was stopped by f.
+     */
+    template <typename F>
+    bool forEachSetWhile(F&& f) const {
+        for (std::size_t wi = 0; wi < words.size(); ++wi) {
+            std::uint64_t w = words[wi];
+            while (w) {
+                if (!f(wi * 64 + lowestBit(w))) return false;
+                w &= w - 1;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Raw word access for bulk operations.
+     */
+    const std::vector<std::uint64_t>& data() const { return words; }
+    std::vector<std::uint64_t>& data() { return words; }
+};
+
+} // namespace bk
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @brief A booked period of one vehicle.
+ *
+ * The period is [startDay, endDay) in Date day numbers: the vehicle is
+ * handed back on endDay, so another booking may start that day.
+ */
+struct Booking {
+    std::int32_t startDay = 0;
+    std::int32_t endDay = 0;
+    std::string customerId;
+};
+
+/**
+ * @class BookingCalendar
+ * @brief Future bookings per vehicle slot.
+ *
+ * The bookings of a slot never overlap and are kept in a flat vector sorted
+ * by start day, so their end days are sorted too and an overlap check is a
+ * binary search: O(log n) in the slot's bookings. A bitmap of slots that
+ * have any booking lets fleet-wide window queries skip every vehicle
+ * without bookings a word at a time.
+ */
+class BookingCalendar {
+private:
+    std::vector<std::vector<Booking>> bookings; ///< Slot ID -> bookings sorted by start day
+    Bitset bookedSlots;                         ///< Bit per slot, set if the slot has bookings
+    std::size_t total = 0;                      ///< Number of bookings
+
+    /**
+     * @brief First booking that ends after a day (the only overlap candidate for a period starting that day).
+     */
+    static std::vector<Booking>::const_iterator firstEndingAfter(const std::vector<Booking>& list, int day) {
+        return std::partition_point(list.begin(), list.end(), [day](const Booking& b) { return b.endDay <= day; });
+    }
+
+public:
+    /**
+     * @brief Make room for slot IDs below n.
+     */
+    void resize(std::size_t n) {
+        if (n <= bookings.size()) return;
+        bookings.resize(n);
+        bookedSlots.resize(n);
+    }
+
+    /**
+     * @brief Find a booking of a slot that overlaps [startDay, endDay).
+     * @return The earliest overlapping booking or nullptr.
+     */
+    const Booking* findOverlap(std::size_t slot, int startDay, int endDay) const {
+        if (slot >= bookings.size()) return nullptr;
+        const auto& list = bookings[slot];
+        auto it = firstEndingAfter(list, startDay);
+        return it != list.end() && it->startDay < endDay ? &*it : nullptr;
+    }
+
+    /**
+     * @brief Add a booking.
+     * @return false if it overlaps another booking of the slot (nothing is added).
+     */
+    bool add(std::size_t slot, Booking booking) {
+        resize(slot + 1);
+        if (findOverlap(slot, booking.startDay, booking.endDay)) return false;
+        auto& list = bookings[slot];
+        auto pos = std::partition_point(list.begin(), list.end(),
+                                        [&](const Booking& b) { return b.startDay < booking.startDay; });
+        list.insert(pos, std::move(booking));
+        bookedSlots.set(slot);
+        ++total;
+        return true;
+    }
+
+    /**
+     * @brief Remove the booking of a slot that starts on a day.
+     * @return false if there is none.
+     */
+    bool remove(std::size_t slot, int startDay) {
+        if (slot >= bookings.size()) return false;
+        auto& list = bookings[slot];
+        auto pos = std::partition_point(list.begin(), list.end(),
+                                        [startDay](const Booking& b) { return b.startDay < startDay; });
+        if (pos == list.end() || pos->startDay != startDay) return false;
+        list.erase(pos);
+        if (list.empty()) bookedSlots.reset(slot);
+        --total;
+        return true;
+    }
+
+    /**
+     * @brief Get the bookings of a slot, sorted by start day.
+     */
+    const std::vector<Booking>& bookingsOf(std::size_t slot) const {
+        static const std::vector<Booking> none;
+        return slot < bookings.size() ? bookings[slot] : none;
+    }
+
+    bool hasBookings(std::size_t slot) const { return slot < bookings.size() && !bookings[slot].empty(); }
+
+    /**
+     * @brief Clear the bits of the slots that are booked at any time in [startDay, endDay).
+     */
+    void removeBooked(Bitset& slots, int startDay, int endDay) const {
+        bookedSlots.forEachSet([&](std::size_t slot) {
+            if (slot < slots.size() && findOverlap(slot, startDay, endDay)) slots.reset(slot);
+        });
+    }
+
+    /**
+     * @brief Call f(slot, booking) for every booking, by slot and start day.
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        bookedSlots.forEachSet([&](std::size_t slot) {
+            for (const auto& b : bookings[slot]) f(slot, b);
+        });
+    }
+
+    std::size_t size() const { return total; }
+
+    void clear() {
+        bookings.clear();
+        bookedSlots.clear();
+        total = 0;
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,299 @@
+#pragma once
+
+#include "FileIO.hpp"
+#include "Journal.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace bk {
+
+/**
+ * @class Checkpointer
+ * @brief Writes checkpoints of VehicleManager state on a background thread.
+ *
+ * A checkpoint is a manifest file naming one segment file per section
+ * (vehicles, customers, rentals, history, reservations, maintenance). A
+ * segment holds the section in the text data file format, so the segments
+ * concatenated in order form a complete data file. Only sections that changed are written, as new
+ * segment files; unchanged sections keep pointing at their old segments.
+ * The manifest is replaced atomically after the new segments are on disk,
+ * so a crash leaves either the old or the new checkpoint. Afterwards the
+ * replaced segments are deleted and the journal is compacted up to the
+ * last operation contained in the checkpoint.
+ *
+ * Manifest layout (text):
+ *   BKVM 1
+ *   generation <n>
+ *   journal <journal ID> <last sequence number>
+ *   <section name> <segment file name>   (one line per section, in order)
+ * Manifests written before a section existed end early; the missing
+ * sections are empty. A generation 0 manifest has no segments: it only
+ * records the journal ID of state seeded from a data file, until the first
+ * checkpoint.
+ */
+class Checkpointer {
+public:
+    /**
+     * @brief Sections of the data file, in file order.
+     */
+    enum class Section { Vehicles, Customers, Rentals, History, Reservations, Maintenance };
+    static constexpr int sectionCount = 6;
+
+    /**
+     * @brief Contents of a manifest.
+     */
+    struct Manifest {
+        std::uint64_t generation = 0;   ///< Incremented by every checkpoint
+        std::uint64_t journalId = 0;    ///< ID of the journal continuing this checkpoint
+        std::uint64_t lastSequence = 0; ///< Last journal entry contained in the checkpoint
+        std::array<std::string, sectionCount> segments; ///< Segment file names (relative to the manifest)
+    };
+
+    /**
+     * @brief New contents of the sections that changed (nullopt = unchanged).
+     */
+    using SectionTexts = std::array<std::optional<std::string>, sectionCount>;
+
+private:
+    std::string manifestPath;
+    std::string directory;    ///< Directory of the manifest, with trailing separator
+    Manifest current;         ///< Last committed manifest (worker thread only)
+    Journal* journal;         ///< Journal to compact (not owned, may be null)
+
+    std::optional<SectionTexts> pendingTexts; ///< Next job, merged with later submissions
+    std::uint64_t pendingSequence = 0;
+    bool busy = false;        ///< The worker is writing a checkpoint
+    bool stopping = false;
+    std::optional<SectionTexts> retry; ///< Sections of a failed checkpoint, merged into the next one
+    std::string error;        ///< Message of the last failed checkpoint
+    std::mutex mutex;
+    std::condition_variable wakeWorker;
+    std::condition_variable idle;
+    std::thread worker;
+
+    static const char* sectionName(int s) {
+        static const char* const names[sectionCount] = {"vehicles", "customers", "rentals", "history",
+                                                        "reservations", "maintenance"};
+        return names[s];
+    }
+
+    /**
+     * @brief Merge newer section texts over older ones.
+     */
+    static void mergeInto(SectionTexts& older, SectionTexts&& newer) {
+        for (int s = 0; s < sectionCount; ++s) {
+            if (newer[s]) older[s] = std::move(newer[s]);
+        }
+    }
+
+    static std::string render(const Manifest& m) {
+        std::ostringstream out;
+        out << "BKVM 1\n"
+            << "generation " << m.generation << "\n"
+            << "journal " << m.journalId << " " << m.lastSequence << "\n";
+        for (int s = 0; s < sectionCount; ++s) out << sectionName(s) << " " << m.segments[s] << "\n";
+        return out.str();
+    }
+
+    /**
+     * @brief Write one checkpoint.
+     * @throws std::runtime_error If a file cannot be written.
+     */
+    void write(const SectionTexts& texts, std::uint64_t lastSequence) {
+        Manifest next = current;
+        next.generation = current.generation + 1;
+        next.lastSequence = lastSequence;
+        std::string baseName = manifestPath.substr(directory.size());
+        for (int s = 0; s < sectionCount; ++s) {
+            if (!texts[s] && !current.segments[s].empty()) continue;
+            next.segments[s] = baseName + "." + sectionName(s) + "." + std::to_string(next.generation);
+            const std::string empty = "0\n";
+            if (!FileIO::writeDurably(directory + next.segments[s], texts[s] ? *texts[s] : empty)) {
+                throw std::runtime_error("Could not write checkpoint segment.");
+            }
+        }
+        writeManifest(manifestPath, next);
+
+        for (int s = 0; s < sectionCount; ++s) {
+            if (next.segments[s] != current.segments[s] && !current.segments[s].empty()) {
+                std::remove((directory + current.segments[s]).c_str());
+            }
+        }
+        current = next;
+        if (journal) journal->compact(lastSequence);
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wakeWorker.wait(lock, [this] { return stopping || pendingTexts; });
+            if (!pendingTexts) return; // stopping and drained
+            SectionTexts texts = std::move(*pendingTexts);
+            std::uint64_t sequence = pendingSequence;
+            pendingTexts.reset();
+            busy = true;
+            lock.unlock();
+            std::string failure;
+            try {
+                write(texts, sequence);
+            } catch (const std::exception& e) {
+                failure = e.what();
+            }
+            lock.lock();
+            busy = false;
+            if (!failure.empty()) {
+                error = failure;
+                // Retry the sections with the next checkpoint
+                if (pendingTexts) {
+                    mergeInto(texts, std::move(*pendingTexts));
+                    pendingTexts = std::move(texts);
+                } else {
+                    retry = std::move(texts);
+                }
+            }
+            idle.notify_all();
+        }
+    }
+
+public:
+    /**
+     * @brief Start the background writer.
+     * @param manifestFile Path to the manifest.
+     * @param committed Manifest currently on disk (generation 0 if there is none).
+     * @param log Journal to compact after each checkpoint (may be null).
+     */
+    Checkpointer(const std::string& manifestFile, const Manifest& committed, Journal* log)
+        : manifestPath(manifestFile), current(committed), journal(log) {
+        std::size_t sep = manifestPath.find_last_of("/\\");
+        directory = sep == std::string::npos ? "" : manifestPath.substr(0, sep + 1);
+        worker = std::thread([this] { run(); });
+    }
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    /**
+     * @brief Finish the queued checkpoint and stop.
+     */
+    ~Checkpointer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWorker.notify_one();
+        worker.join();
+    }
+
+    /**
+     * @brief Queue a checkpoint and return immediately.
+     * If a checkpoint is already queued, the two are merged.
+     * @param texts Sections that changed since the previous submission.
+     * @param lastSequence Last journal entry reflected in the texts.
+     */
+    void submit(SectionTexts texts, std::uint64_t lastSequence) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (retry) {
+                mergeInto(*retry, std::move(texts));
+                texts = std::move(*retry);
+                retry.reset();
+            }
+            if (pendingTexts) {
+                mergeInto(*pendingTexts, std::move(texts));
+            } else {
+                pendingTexts = std::move(texts);
+            }
+            pendingSequence = lastSequence;
+        }
+        wakeWorker.notify_one();
+    }
+
+    /**
+     * @brief Wait until all submitted checkpoints are written.
+     * @throws std::runtime_error If the last checkpoint failed.
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return !busy && !pendingTexts; });
+        if (!error.empty()) {
+            std::string message = error;
+            error.clear();
+            throw std::runtime_error(message);
+        }
+    }
+
+    /**
+     * @brief Replace a manifest atomically.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void writeManifest(const std::string& filename, const Manifest& m) {
+        if (!FileIO::writeAtomically(filename, render(m))) {
+            throw std::runtime_error("Could not write checkpoint manifest.");
+        }
+    }
+
+    /**
+     * @brief Read a manifest.
+     * @return false if the file does not exist.
+     * @throws std::runtime_error If the manifest is malformed.
+     */
+    static bool readManifest(const std::string& filename, Manifest& m) {
+        std::string bytes;
+        if (!FileIO::readAll(filename, bytes)) return false;
+        std::istringstream in(bytes);
+        std::string line;
+        auto field = [&](const char* name, bool optional = false) {
+            if (!std::getline(in, line)) {
+                if (optional) return std::string();
+                throw std::runtime_error("Corrupt checkpoint manifest.");
+            }
+            if (line.compare(0, std::strlen(name) + 1, std::string(name) + " ") != 0) {
+                throw std::runtime_error("Corrupt checkpoint manifest.");
+            }
+            return line.substr(std::strlen(name) + 1);
+        };
+        if (field("BKVM") != "1") throw std::runtime_error("Not a checkpoint manifest.");
+        try {
+            m.generation = std::stoull(field("generation"));
+            std::string journalLine = field("journal");
+            std::size_t space = journalLine.find(' ');
+            m.journalId = std::stoull(journalLine.substr(0, space));
+            m.lastSequence = std::stoull(journalLine.substr(space + 1));
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Corrupt checkpoint manifest.");
+        }
+        for (int s = 0; s < sectionCount; ++s) {
+            m.segments[s] = field(sectionName(s), s > static_cast<int>(Section::History));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Concatenate the segments of a manifest into a data file image.
+     * @throws std::runtime_error If a segment is missing.
+     */
+    static std::string readSegments(const std::string& manifestFile, const Manifest& m) {
+        std::size_t sep = manifestFile.find_last_of("/\\");
+        std::string dir = sep == std::string::npos ? "" : manifestFile.substr(0, sep + 1);
+        std::string text;
+        for (const auto& segment : m.segments) {
+            if (segment.empty()) continue; // Section added after the checkpoint was written
+            std::string bytes;
+            if (!FileIO::readAll(dir + segment, bytes)) throw std::runtime_error("Missing checkpoint segment.");
+            text += bytes;
+        }
+        return text;
+    }
+};
+
+} // namespace bk
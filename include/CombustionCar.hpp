@@ -87,6 +87,13 @@ public:
         return MainVehicleType::Car;
     }
 
+    /**
+     * @brief Get concrete vehicle kind.
+     */
+    VehicleKind getKind() const override {
+        return VehicleKind::CombustionCar;
+    }
+
     // Setters
     /**
      * @brief Set number of doors.
@@ -95,6 +102,7 @@ public:
     void setDoors(int num) {
         if (num <= 0) throw std::invalid_argument("Doors must be positive.");
         doors = num;
+        notifyChanged();
     }
     
     // Getters
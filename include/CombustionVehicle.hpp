@@ -58,7 +58,7 @@ public:
         if (engineSize <= 0) {
             throw std::invalid_argument("Engine size must be positive.");
         }
-        if (fuelConsumption <= 0) {
+        if (!(fuelConsumption > 0)) { // also rejects NaN
             throw std::invalid_argument("Fuel consumption must be positive.");
         }
     }
@@ -98,6 +98,7 @@ public:
             throw std::invalid_argument("Engine size must be positive.");
         }
         engineSize = size;
+        notifyChanged();
     }
 
     /**
@@ -106,10 +107,11 @@ public:
      * @throws std::invalid_argument If consumption is non-positive.
      */
     void setFuelConsumption(double consumption) {
-        if (consumption <= 0) {
+        if (!(consumption > 0)) {
             throw std::invalid_argument("Fuel consumption must be positive.");
         }
         fuelConsumption = consumption;
+        notifyChanged();
     }
 
     /**
@@ -121,6 +123,7 @@ public:
             throw std::invalid_argument("Invalid fuel type.");
         }
         fuelType = type;
+        notifyChanged();
     }
 
     /**
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <stdexcept>
 #include <sstream>
 
@@ -14,6 +15,8 @@ enum class CustomerType {
     Business
 };
 
+constexpr int customerTypeCount = 2; ///< Number of CustomerType values
+
 /**
  * @class Customer
  * @brief Abstract base class representing a customer.
@@ -40,9 +43,17 @@ public:
     Customer(const std::string& idVal, const std::string& nameVal, const std::string& addrVal)
         : id(idVal), name(nameVal), address(addrVal)
     {
-        if (id.empty()) throw std::invalid_argument("ID cannot be empty.");
-        if (name.empty()) throw std::invalid_argument("Name cannot be empty.");
-        if (address.empty()) throw std::invalid_argument("Address cannot be empty.");
+        validate(id, name, address);
+    }
+
+    /**
+     * @brief Check the fields validated by the constructor (also used on snapshot records).
+     * @throws std::invalid_argument If a field is empty.
+     */
+    static void validate(std::string_view idVal, std::string_view nameVal, std::string_view addrVal) {
+        if (idVal.empty()) throw std::invalid_argument("ID cannot be empty.");
+        if (nameVal.empty()) throw std::invalid_argument("Name cannot be empty.");
+        if (addrVal.empty()) throw std::invalid_argument("Address cannot be empty.");
     }
 
     /**
@@ -62,10 +73,10 @@ public:
      */
     virtual CustomerType getType() const = 0;
 
-    // Getters
-    std::string getId() const { return id; }
-    std::string getName() const { return name; }
-    std::string getAddress() const { return address; }
+    // Getters (return references to avoid copying in search loops)
+    const std::string& getId() const { return id; }
+    const std::string& getName() const { return name; }
+    const std::string& getAddress() const { return address; }
 
     /**
      * @brief Stream insertion operator.
@@ -115,7 +126,7 @@ public:
         return CustomerType::Private;
     }
 
-    std::string getIdCardNumber() const { return idCardNumber; }
+    const std::string& getIdCardNumber() const { return idCardNumber; }
 };
 
 /**
@@ -154,7 +165,7 @@ public:
     }
 
     CustomerType getType() const override {return CustomerType::Business;}
-    std::string getNip() const { return nip; }
+    const std::string& getNip() const { return nip; }
 };
 
 } // namespace bk
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace bk {
+
+/**
+ * @class Date
+ * @brief Conversions between "YYYY-MM-DD" strings and day numbers.
+ *
+ * Day numbers count days of the proleptic Gregorian calendar with
+ * 0001-01-01 as day 1, so the difference of two day numbers is the number
+ * of days between the dates. Conversions are closed-form (no loops over
+ * years or months) and constexpr.
+ */
+class Date {
+private:
+    static constexpr int monthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+public:
+    /**
+     * @brief Day number of a calendar date (no validation).
+     */
+    static constexpr int toDayNumber(int year, int month, int day) {
+        // Shift the year to start in March so the leap day is the last day of the year
+        year -= month <= 2;
+        const int era = (year >= 0 ? year : year - 399) / 400;
+        const int yearOfEra = year - era * 400;
+        const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 305; // 0001-01-01 -> 1
+    }
+
+    /**
+     * @brief Parse a "YYYY-MM-DD" date.
+     * @param day Receives the day number.
+     * @return false if the string is not a valid date.
+     */
+    static constexpr bool parse(std::string_view s, int& day) {
+        if (s.size() != 10 || s[4] != '-' || s[7] != '-') return false;
+        int fields[3] = {0, 0, 0};
+        int field = 0;
+        for (std::size_t i = 0; i < 10; ++i) {
+            if (i == 4 || i == 7) {
+                ++field;
+                continue;
+            }
+            if (s[i] < '0' || s[i] > '9') return false;
+            fields[field] = fields[field] * 10 + (s[i] - '0');
+        }
+        const int year = fields[0], month = fields[1], dom = fields[2];
+        if (month < 1 || month > 12 || dom < 1 || dom > daysInMonth(month, year)) return false;
+        day = toDayNumber(year, month, dom);
+        return true;
+    }
+
+    /**
+     * @brief Day number of a "YYYY-MM-DD" date.
+     * @throws std::invalid_argument If the string is not a valid date.
+     */
+    static int toDayNumber(std::string_view s) {
+        int day = 0;
+        if (!parse(s, day)) throw std::invalid_argument("Date must be in format YYYY-MM-DD.");
+        return day;
+    }
+
+    /**
+     * @brief Calendar date of a day number.
+     */
+    static constexpr void toCivil(int dayNumber, int& year, int& month, int& day) {
+        const int z = dayNumber + 305; // days since 0000-03-01
+        const int era = (z >= 0 ? z : z - 146096) / 146097;
+        const int dayOfEra = z - era * 146097;
+        const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int mp = (5 * dayOfYear + 2) / 153;
+        day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        month = mp < 10 ? mp + 3 : mp - 9;
+        year = yearOfEra + era * 400 + (month <= 2);
+    }
+
+    /**
+     * @brief Format a day number as "YYYY-MM-DD".
+     */
+    static std::string toString(int dayNumber) {
+        int year = 0, month = 0, day = 0;
+        toCivil(dayNumber, year, month, day);
+
+        char buf[32]; // Room for any int year, month and day
+        std::snprintf(buf, sizeof buf, "%04d-%02d-%02d", year, month, day);
+        return buf;
+    }
+
+    /**
+     * @brief Day number of the current local date.
+     */
+    static int today() {
+        std::time_t now = std::time(nullptr);
+        std::tm local{};
+#if defined(_WIN32)
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        return toDayNumber(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+    }
+
+    static constexpr bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+    }
+
+    /**
+     * @brief Number of days in a month (0 for an invalid month).
+     */
+    static constexpr int daysInMonth(int month, int year) {
+        if (month < 1 || month > 12) return 0;
+        return monthDays[month - 1] + (month == 2 && isLeapYear(year));
+    }
+};
+
+static_assert(Date::toDayNumber(1, 1, 1) == 1, "0001-01-01 is day 1");
+static_assert(Date::toDayNumber(2024, 3, 1) - Date::toDayNumber(2024, 2, 28) == 2, "2024 is a leap year");
+static_assert(Date::toDayNumber(2100, 3, 1) - Date::toDayNumber(2100, 2, 28) == 1, "2100 is not a leap year");
+
+} // namespace bk
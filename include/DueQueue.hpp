@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class DueQueue
+ * @brief Indexed binary min-heap of vehicle slot IDs keyed by a due day.
+ *
+ * Each slot is in the heap at most once and its heap position is tracked,
+ * so inserting, moving and removing a slot are O(log n). Walking the slots
+ * due before a day visits only those slots: a second, small heap holds the
+ * frontier of the walk, so k slots are reported in due order in O(k log k).
+ */
+class DueQueue {
+public:
+    /**
+     * @brief A slot and the day it is due.
+     */
+    struct Entry {
+        std::int32_t dueDay = 0;
+        std::size_t slot = 0;
+    };
+
+private:
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    std::vector<Entry> heap;          ///< Min-heap on (dueDay, slot)
+    std::vector<std::size_t> position; ///< Slot ID -> index in heap (none if absent)
+
+    static bool before(const Entry& a, const Entry& b) {
+        return a.dueDay != b.dueDay ? a.dueDay < b.dueDay : a.slot < b.slot;
+    }
+
+    void place(std::size_t i, const Entry& e) {
+        heap[i] = e;
+        position[e.slot] = i;
+    }
+
+    void siftUp(std::size_t i) {
+        Entry e = heap[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / 2;
+            if (!before(e, heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, e);
+    }
+
+    void siftDown(std::size_t i) {
+        Entry e = heap[i];
+        for (;;) {
+            std::size_t child = 2 * i + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && before(heap[child + 1], heap[child])) ++child;
+            if (!before(heap[child], e)) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, e);
+    }
+
+public:
+    bool contains(std::size_t slot) const { return slot < position.size() && position[slot] != none; }
+
+    /**
+     * @brief Add a slot or move it to a new due day.
+     */
+    void set(std::size_t slot, std::int32_t dueDay) {
+        if (slot >= position.size()) position.resize(slot + 1, none);
+        if (position[slot] == none) {
+            heap.push_back(Entry{dueDay, slot});
+            position[slot] = heap.size() - 1;
+            siftUp(heap.size() - 1);
+            return;
+        }
+        std::size_t i = position[slot];
+        std::int32_t old = heap[i].dueDay;
+        heap[i].dueDay = dueDay;
+        if (dueDay < old) {
+            siftUp(i);
+        } else {
+            siftDown(i);
+        }
+    }
+
+    /**
+     * @brief Remove a slot (no-op if it is not in the queue).
+     */
+    void erase(std::size_t slot) {
+        if (!contains(slot)) return;
+        std::size_t i = position[slot];
+        position[slot] = none;
+        Entry last = heap.back();
+        heap.pop_back();
+        if (i == heap.size()) return;
+        place(i, last);
+        if (i > 0 && before(last, heap[(i - 1) / 2])) {
+            siftUp(i);
+        } else {
+            siftDown(i);
+        }
+    }
+
+    /**
+     * @brief Call f(entry) for every slot due before a day, earliest first.
+     */
+    template <typename F>
+    void forEachDueBefore(std::int32_t day, F&& f) const {
+        auto later = [this](std::size_t a, std::size_t b) { return before(heap[b], heap[a]); };
+        std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> frontier(later);
+        if (!heap.empty() && heap[0].dueDay < day) frontier.push(0);
+        while (!frontier.empty()) {
+            std::size_t i = frontier.top();
+            frontier.pop();
+            f(heap[i]);
+            for (std::size_t child = 2 * i + 1; child <= 2 * i + 2 && child < heap.size(); ++child) {
+                if (heap[child].dueDay < day) frontier.push(child);
+            }
+        }
+    }
+
+    std::size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+
+    /**
+     * @brief Earliest due entry (the queue must not be empty).
+     */
+    const Entry& top() const { return heap.front(); }
+
+    void clear() {
+        heap.clear();
+        position.clear();
+    }
+};
+
+} // namespace bk
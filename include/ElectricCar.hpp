@@ -79,6 +79,13 @@ public:
         return MainVehicleType::Car;
     }
 
+    /**
+     * @brief Get concrete vehicle kind.
+     */
+    VehicleKind getKind() const override {
+        return VehicleKind::ElectricCar;
+    }
+
     // Setters
     /**
      * @brief Set number of doors.
@@ -87,6 +94,7 @@ public:
     void setDoors(int num) {
         if (num <= 0) throw std::invalid_argument("Doors must be positive.");
         doors = num;
+        notifyChanged();
     }
 
     // Getters
@@ -35,7 +35,7 @@ public:
                     double miles, double cost, LicenceCategory cat, double battery)
         : Vehicle(reg, brand, model, miles, cost, cat), batteryCapacity(battery)
     {
-        if (batteryCapacity <= 0.0) {
+        if (!(batteryCapacity > 0.0)) { // also rejects NaN
             throw std::invalid_argument("Battery capacity must be positive.");
         }
     }
@@ -59,10 +59,11 @@ public:
      * @throws std::invalid_argument If capacity is non-positive.
      */
     void setBatteryCapacity(double capacity) {
-        if (capacity <= 0.0) {
+        if (!(capacity > 0.0)) {
             throw std::invalid_argument("Battery capacity must be positive.");
         }
         batteryCapacity = capacity;
+        notifyChanged();
     }
 };
 
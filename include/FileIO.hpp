@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bk {
+
+/**
+ * @class FileIO
+ * @brief Low-level file operations needed for crash-safe persistence.
+ */
+class FileIO {
+public:
+    /**
+     * @brief Open a file for writing, creating it if needed (the position is at the start).
+     * @return File descriptor, or -1 on failure.
+     */
+    static int openForWrite(const std::string& filename) {
+#ifdef _WIN32
+        return _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        return ::open(filename.c_str(), O_WRONLY | O_CREAT, 0644);
+#endif
+    }
+
+    static void close(int fd) {
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+    /**
+     * @brief Write all bytes at the current position.
+     */
+    static bool writeAll(int fd, const char* data, std::size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            int n = _write(fd, data, static_cast<unsigned>(size));
+#else
+            ssize_t n = ::write(fd, data, size);
+#endif
+            if (n <= 0) return false;
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Flush written data to the storage device.
+     */
+    static bool sync(int fd) {
+#ifdef _WIN32
+        return _commit(fd) == 0;
+#else
+        return fsync(fd) == 0;
+#endif
+    }
+
+    /**
+     * @brief Cut a file to a length and move the position to its end.
+     */
+    static bool truncate(int fd, std::size_t length) {
+#ifdef _WIN32
+        if (_chsize_s(fd, static_cast<long long>(length)) != 0) return false;
+        return _lseeki64(fd, 0, SEEK_END) >= 0;
+#else
+        if (ftruncate(fd, static_cast<off_t>(length)) != 0) return false;
+        return lseek(fd, 0, SEEK_END) >= 0;
+#endif
+    }
+
+    /**
+     * @brief Create or overwrite a file and flush it to the storage device.
+     */
+    static bool writeDurably(const std::string& filename, std::string_view bytes) {
+        int fd = openForWrite(filename);
+        if (fd < 0) return false;
+        bool ok = truncate(fd, 0) && writeAll(fd, bytes.data(), bytes.size()) && sync(fd);
+        close(fd);
+        return ok;
+    }
+
+    /**
+     * @brief Flush the directory entries of a file's parent directory to the storage device.
+     * A new or renamed file is only durable once its directory is (no-op on Windows,
+     * where MOVEFILE_WRITE_THROUGH covers renames).
+     */
+    static bool syncParentDirectory(const std::string& filename) {
+#ifdef _WIN32
+        (void)filename;
+        return true;
+#else
+        std::size_t sep = filename.find_last_of('/');
+        std::string dir = sep == std::string::npos ? "." : filename.substr(0, sep == 0 ? 1 : sep);
+        int fd = ::open(dir.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        // Some file systems cannot sync directories; there is nothing more to do on them
+        bool ok = fsync(fd) == 0 || errno == EINVAL;
+        ::close(fd);
+        return ok;
+#endif
+    }
+
+    /**
+     * @brief Atomically and durably replace target with source (both on the same file system).
+     */
+    static bool replace(const std::string& source, const std::string& target) {
+#ifdef _WIN32
+        return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        return std::rename(source.c_str(), target.c_str()) == 0 && syncParentDirectory(target);
+#endif
+    }
+
+    /**
+     * @brief Replace a file by writing a temporary file and renaming it over the target.
+     * A crash leaves either the old or the new contents, and a mapped old file stays intact.
+     */
+    static bool writeAtomically(const std::string& filename, std::string_view bytes) {
+        const std::string tmpName = filename + ".tmp";
+        if (writeDurably(tmpName, bytes) && replace(tmpName, filename)) return true;
+        std::remove(tmpName.c_str());
+        return false;
+    }
+
+    /**
+     * @brief Names of the regular files in a directory (empty if it cannot be read).
+     * @param directory Directory path, with or without trailing separator ("" for the current one).
+     */
+    static std::vector<std::string> listDirectory(const std::string& directory) {
+        std::vector<std::string> names;
+        std::error_code ec;
+        std::filesystem::directory_iterator it(directory.empty() ? "." : directory, ec), end;
+        for (; !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec)) names.push_back(it->path().filename().string());
+        }
+        return names;
+    }
+
+    /**
+     * @brief Check whether two paths name the same existing file.
+     */
+    static bool sameFile(const std::string& a, const std::string& b) {
+        std::error_code ec;
+        return std::filesystem::equivalent(a, b, ec) && !ec;
+    }
+
+    /**
+     * @brief Read a whole file.
+     * @return false if the file cannot be opened.
+     */
+    static bool readAll(const std::string& filename, std::string& bytes) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "CombustionVehicle.hpp"
+#include "ElectricVehicle.hpp"
+#include "Truck.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class FleetColumns
+ * @brief Structure-of-arrays copy of the numeric vehicle attributes.
+ *
+ * Row i describes the vehicle in slot i of VehicleManager. Free slots have
+ * live[i] == 0. Attributes that do not apply to a vehicle type are stored as 0
+ * (noFuelType for the fuel type column).
+ * Filters run as plain loops over contiguous arrays, which the compiler can
+ * vectorize, instead of following a pointer to every vehicle.
+ */
+class FleetColumns {
+private:
+    std::vector<double> baseCost;        ///< Base daily cost in zl
+    std::vector<double> mileage;         ///< Mileage in km
+    std::vector<std::uint8_t> licence;   ///< LicenceCategory as integer
+    std::vector<std::uint8_t> kind;      ///< VehicleKind as integer
+    std::vector<std::int32_t> engineSize; ///< Engine size in cm3 (0 for electric)
+    std::vector<double> fuelConsumption; ///< Fuel consumption in L/100km (0 for electric)
+    std::vector<std::uint8_t> fuelType; ///< FuelType as integer (noFuelType for electric)
+    std::vector<double> batteryCapacity; ///< Battery capacity in kWh (0 for combustion)
+    std::vector<std::int32_t> cargoCapacity; ///< Cargo capacity in kg (0 if not a truck)
+    std::vector<std::uint8_t> live;      ///< 1 if the slot holds a vehicle
+
+    /**
+     * @brief Turn a 0/1 mask into the list of selected rows.
+     */
+    static std::vector<std::size_t> compact(const std::vector<std::uint8_t>& mask) {
+        std::vector<std::size_t> rows;
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            if (mask[i]) rows.push_back(i);
+        }
+        return rows;
+    }
+
+public:
+    static constexpr std::uint8_t noFuelType = 0xFF; ///< fuelType value of electric vehicles
+
+    /**
+     * @brief Number of rows (equal to the number of vehicle slots).
+     */
+    std::size_t size() const { return live.size(); }
+
+    /**
+     * @brief Values of one row.
+     */
+    struct Row {
+        double baseCost = 0.0;
+        double mileage = 0.0;
+        std::uint8_t licence = 0;
+        std::uint8_t kind = 0;
+        std::int32_t engineSize = 0;
+        double fuelConsumption = 0.0;
+        std::uint8_t fuelType = noFuelType;
+        double batteryCapacity = 0.0;
+        std::int32_t cargoCapacity = 0;
+    };
+
+    /**
+     * @brief Extract the row values of a vehicle.
+     */
+    static Row rowOf(const Vehicle& v) {
+        Row r;
+        r.baseCost = v.getBaseCost();
+        r.mileage = v.getMileage();
+        r.licence = static_cast<std::uint8_t>(v.getLicenceCategory());
+        r.kind = static_cast<std::uint8_t>(v.getKind());
+        if (v.getKind() == Vehicle::VehicleKind::ElectricCar) {
+            r.batteryCapacity = static_cast<const ElectricVehicle&>(v).getBatteryCapacity();
+        } else {
+            const auto& cv = static_cast<const CombustionVehicle&>(v);
+            r.engineSize = cv.getEngineSize();
+            r.fuelConsumption = cv.getFuelConsumption();
+            r.fuelType = static_cast<std::uint8_t>(cv.getFuelType());
+        }
+        if (v.getKind() == Vehicle::VehicleKind::Truck) {
+            r.cargoCapacity = static_cast<const Truck&>(v).getCargoCapacity();
+        }
+        return r;
+    }
+
+    /**
+     * @brief Write row values, growing the columns if needed.
+     */
+    void store(std::size_t row, const Row& r) {
+        if (row >= size()) {
+            std::size_t n = row + 1;
+            baseCost.resize(n, 0.0);
+            mileage.resize(n, 0.0);
+            licence.resize(n, 0);
+            kind.resize(n, 0);
+            engineSize.resize(n, 0);
+            fuelConsumption.resize(n, 0.0);
+            fuelType.resize(n, noFuelType);
+            batteryCapacity.resize(n, 0.0);
+            cargoCapacity.resize(n, 0);
+            live.resize(n, 0);
+        }
+
+        baseCost[row] = r.baseCost;
+        mileage[row] = r.mileage;
+        licence[row] = r.licence;
+        kind[row] = r.kind;
+        engineSize[row] = r.engineSize;
+        fuelConsumption[row] = r.fuelConsumption;
+        fuelType[row] = r.fuelType;
+        batteryCapacity[row] = r.batteryCapacity;
+        cargoCapacity[row] = r.cargoCapacity;
+        live[row] = 1;
+    }
+
+    /**
+     * @brief Write the attributes of a vehicle into a row, growing the columns if needed.
+     */
+    void store(std::size_t row, const Vehicle& v) { store(row, rowOf(v)); }
+
+    /**
+     * @brief Mark a row as free.
+     */
+    void erase(std::size_t row) { live[row] = 0; }
+
+    /**
+     * @brief Remove all rows.
+     */
+    void clear() {
+        baseCost.clear();
+        mileage.clear();
+        licence.clear();
+        kind.clear();
+        engineSize.clear();
+        fuelConsumption.clear();
+        fuelType.clear();
+        batteryCapacity.clear();
+        cargoCapacity.clear();
+        live.clear();
+    }
+
+    /**
+     * @brief Pre-allocate storage for n rows.
+     */
+    void reserve(std::size_t n) {
+        baseCost.reserve(n);
+        mileage.reserve(n);
+        licence.reserve(n);
+        kind.reserve(n);
+        engineSize.reserve(n);
+        fuelConsumption.reserve(n);
+        fuelType.reserve(n);
+        batteryCapacity.reserve(n);
+        cargoCapacity.reserve(n);
+        live.reserve(n);
+    }
+
+    // Column access
+    const std::vector<double>& getBaseCosts() const { return baseCost; }
+    const std::vector<double>& getMileages() const { return mileage; }
+    const std::vector<std::uint8_t>& getLicences() const { return licence; }
+    const std::vector<std::uint8_t>& getKinds() const { return kind; }
+    const std::vector<std::int32_t>& getEngineSizes() const { return engineSize; }
+    const std::vector<double>& getFuelConsumptions() const { return fuelConsumption; }
+    const std::vector<std::uint8_t>& getFuelTypes() const { return fuelType; }
+    const std::vector<double>& getBatteryCapacities() const { return batteryCapacity; }
+    const std::vector<std::int32_t>& getCargoCapacities() const { return cargoCapacity; }
+    const std::vector<std::uint8_t>& getLive() const { return live; }
+
+    // --- Scans ---
+
+    /**
+     * @brief Rows with base cost <= maxCost.
+     */
+    std::vector<std::size_t> selectCostAtMost(double maxCost) const {
+        std::vector<std::uint8_t> mask(size());
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = live[i] & static_cast<std::uint8_t>(baseCost[i] <= maxCost);
+        }
+        return compact(mask);
+    }
+
+    /**
+     * @brief Rows with mileage <= maxMileage.
+     */
+    std::vector<std::size_t> selectMileageAtMost(double maxMileage) const {
+        std::vector<std::uint8_t> mask(size());
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = live[i] & static_cast<std::uint8_t>(mileage[i] <= maxMileage);
+        }
+        return compact(mask);
+    }
+
+    /**
+     * @brief Rows requiring the given licence category.
+     */
+    std::vector<std::size_t> selectLicence(Vehicle::LicenceCategory cat) const {
+        const auto wanted = static_cast<std::uint8_t>(cat);
+        std::vector<std::uint8_t> mask(size());
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = live[i] & static_cast<std::uint8_t>(licence[i] == wanted);
+        }
+        return compact(mask);
+    }
+
+    // --- Pricing ---
+
+    /**
+     * @brief Rental cost of every row for a number of days, as Vehicle::calculateRentCost computes it.
+     *
+     * Trucks add cargoCapacity * 0.1 per day and the cargo column is 0 for
+     * the other types, so one branch-free loop prices every type with the
+     * same arithmetic as the per-vehicle overrides. Free rows get 0. The
+     * results match bit for bit as long as the compiler does not fuse
+     * multiply-adds differently in the two paths (the build turns fusing off).
+     * @param days Positive rental duration (the overrides differ for days <= 0).
+     * @param out Receives size() costs.
+     */
+    void rentCosts(int days, double* out) const {
+        const double d = static_cast<double>(days);
+        for (std::size_t i = 0; i < size(); ++i) {
+            double cost = (baseCost[i] * d) + (cargoCapacity[i] * 0.1 * d);
+            out[i] = live[i] ? cost : 0.0;
+        }
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class HashIndex
+ * @brief Open-addressing hash table mapping string keys to values.
+ *
+ * Linear probing over a power-of-two table. Removal uses backward shifting,
+ * so there are no tombstones and probe chains stay short after many removals.
+ */
+template <typename T>
+class HashIndex {
+private:
+    struct Slot {
+        std::string key;        ///< Stored key
+        T value{};              ///< Stored value
+        std::uint64_t hash = 0; ///< Cached hash of the key
+        bool used = false;      ///< True if the slot holds an entry
+    };
+
+    std::vector<Slot> table; ///< Probe table (size is 0 or a power of two)
+    std::size_t count = 0;   ///< Number of stored entries
+
+    /**
+     * @brief FNV-1a hash of a key.
+     */
+    static std::uint64_t hashKey(std::string_view key) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char ch : key) {
+            h ^= ch;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::size_t mask() const { return table.size() - 1; }
+
+    /**
+     * @brief Find the slot holding a key.
+     * @return Slot position or table.size() if not present.
+     */
+    std::size_t locate(std::string_view key, std::uint64_t h) const {
+        if (table.empty()) return 0;
+        std::size_t i = static_cast<std::size_t>(h) & mask();
+        while (table[i].used) {
+            if (table[i].hash == h && table[i].key == key) return i;
+            i = (i + 1) & mask();
+        }
+        return table.size();
+    }
+
+    /**
+     * @brief Rebuild the table with a new capacity (power of two).
+     */
+    void rehash(std::size_t newCapacity) {
+        std::vector<Slot> old;
+        old.swap(table);
+        table.resize(newCapacity);
+        for (auto& s : old) {
+            if (!s.used) continue;
+            std::size_t i = static_cast<std::size_t>(s.hash) & mask();
+            while (table[i].used) i = (i + 1) & mask();
+            table[i] = std::move(s);
+        }
+    }
+
+    /**
+     * @brief Grow the table so that it can hold n entries below 75% load.
+     */
+    void ensureCapacity(std::size_t n) {
+        std::size_t cap = table.empty() ? 16 : table.size();
+        while (n * 4 > cap * 3) cap *= 2;
+        if (cap != table.size()) rehash(cap);
+    }
+
+public:
+    /**
+     * @brief Pre-size the table for the expected number of entries.
+     */
+    void reserve(std::size_t n) { ensureCapacity(n); }
+
+    /**
+     * @brief Insert a new entry.
+     * @return false if the key already exists (the table is left unchanged).
+     */
+    bool insert(std::string_view key, T value) {
+        ensureCapacity(count + 1);
+        std::uint64_t h = hashKey(key);
+        std::size_t i = static_cast<std::size_t>(h) & mask();
+        while (table[i].used) {
+            if (table[i].hash == h && table[i].key == key) return false;
+            i = (i + 1) & mask();
+        }
+        table[i].key.assign(key.data(), key.size());
+        table[i].value = std::move(value);
+        table[i].hash = h;
+        table[i].used = true;
+        ++count;
+        return true;
+    }
+
+    /**
+     * @brief Find the value stored under a key.
+     * @return Pointer to the value or nullptr if not found.
+     */
+    T* find(std::string_view key) {
+        std::size_t i = locate(key, hashKey(key));
+        return i < table.size() ? &table[i].value : nullptr;
+    }
+
+    const T* find(std::string_view key) const {
+        std::size_t i = locate(key, hashKey(key));
+        return i < table.size() ? &table[i].value : nullptr;
+    }
+
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Remove an entry.
+     * @return false if the key was not present.
+     */
+    bool erase(std::string_view key) {
+        std::size_t hole = locate(key, hashKey(key));
+        if (hole >= table.size()) return false;
+
+        // Shift following entries of the probe chain back into the hole
+        std::size_t j = hole;
+        while (true) {
+            j = (j + 1) & mask();
+            if (!table[j].used) break;
+            std::size_t ideal = static_cast<std::size_t>(table[j].hash) & mask();
+            if (((j - ideal) & mask()) >= ((j - hole) & mask())) {
+                table[hole] = std::move(table[j]);
+                hole = j;
+            }
+        }
+        table[hole].key.clear();
+        table[hole].value = T{};
+        table[hole].used = false;
+        --count;
+        return true;
+    }
+
+    /**
+     * @brief Remove all entries (capacity is kept).
+     */
+    void clear() {
+        for (auto& s : table) {
+            s.key.clear();
+            s.value = T{};
+            s.used = false;
+        }
+        count = 0;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+} // namespace bk
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "RentalHistory.hpp"
+#include "Snapshot.hpp"
+#include "FileIO.hpp"
+#include "Date.hpp"
+#include "TextReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class HistoryLog
+ * @brief Append-only on-disk segments of completed rentals.
+ *
+ * When the in-memory history tail is full it is sealed into a new segment
+ * file that is never modified afterwards, and the tail starts over empty.
+ * The log keeps only a sparse index of the segments (file, record count and
+ * day range), so memory does not grow with the history and saving state
+ * writes the index instead of every record. Readers stream through the
+ * segments one at a time.
+ *
+ * The index itself is part of the saved state (the history section of the
+ * data file or checkpoint), so a segment belongs to the history only once
+ * a save referencing it is on disk. A segment sealed before a crash is
+ * simply unreferenced; its records are recovered from the previous save
+ * and the journal. Segment files are named "<base>.<n>" with n above every
+ * segment file already on disk, so a file referenced by an older save is
+ * never overwritten.
+ *
+ * Segment layout (little-endian): magic "BKVH", u32 version, RentalHistory::write().
+ */
+class HistoryLog {
+public:
+    /**
+     * @brief Sparse index entry of one segment.
+     */
+    struct Segment {
+        std::string file;        ///< File name (relative to the log's directory)
+        std::uint64_t count = 0; ///< Number of records
+        std::int32_t firstDay = 0; ///< Earliest start day of a record
+        std::int32_t lastDay = 0;  ///< Latest end day of a record
+    };
+
+    static constexpr char magic[4] = {'B', 'K', 'V', 'H'};
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::size_t defaultSegmentRecords = 4096;
+
+private:
+    std::string directory;        ///< Directory of the segments, with trailing separator
+    std::string baseName;         ///< Segment file name prefix
+    std::size_t segmentRecords;   ///< Tail size at which the tail is sealed
+    std::vector<Segment> segments; ///< Segments of the current history, oldest first
+    std::uint64_t sealedRecords = 0; ///< Total records in segments
+    std::uint64_t nextId = 0;     ///< Number of the next segment file
+
+    /**
+     * @brief Number of a segment file, or -1 if the name does not belong to this log.
+     */
+    long long idOf(const std::string& file) const {
+        if (file.size() <= baseName.size() + 1 || file.compare(0, baseName.size(), baseName) != 0 ||
+            file[baseName.size()] != '.') {
+            return -1;
+        }
+        if (file.size() - baseName.size() - 1 > 18) return -1; // Not a number we wrote
+        long long id = 0;
+        for (std::size_t i = baseName.size() + 1; i < file.size(); ++i) {
+            if (file[i] < '0' || file[i] > '9') return -1;
+            id = id * 10 + (file[i] - '0');
+        }
+        return id;
+    }
+
+public:
+    /**
+     * @param baseFile Path prefix of the segment files.
+     * @param tailRecords Tail size at which the tail is sealed into a segment.
+     * @throws std::invalid_argument If tailRecords is 0.
+     */
+    explicit HistoryLog(const std::string& baseFile, std::size_t tailRecords = defaultSegmentRecords)
+        : segmentRecords(tailRecords) {
+        if (tailRecords == 0) throw std::invalid_argument("Segment size must be positive.");
+        std::size_t sep = baseFile.find_last_of("/\\");
+        directory = sep == std::string::npos ? "" : baseFile.substr(0, sep + 1);
+        baseName = baseFile.substr(directory.size());
+        for (const auto& file : FileIO::listDirectory(directory)) {
+            long long id = idOf(file);
+            if (id >= 0) nextId = std::max(nextId, static_cast<std::uint64_t>(id) + 1);
+        }
+    }
+
+    std::size_t getSegmentRecords() const { return segmentRecords; }
+    const std::vector<Segment>& getSegments() const { return segments; }
+
+    /**
+     * @brief Total number of records in segments.
+     */
+    std::uint64_t size() const { return sealedRecords; }
+
+    /**
+     * @brief Write the tail into a new segment and add it to the index.
+     * The caller clears the tail afterwards.
+     * @throws std::runtime_error If the segment cannot be written.
+     */
+    void seal(const RentalHistory& tail) {
+        if (tail.empty()) return;
+        Segment seg;
+        seg.file = baseName + "." + std::to_string(nextId);
+        seg.count = tail.size();
+        seg.firstDay = tail.getRecords().front().startDay;
+        seg.lastDay = tail.getRecords().front().endDay;
+        for (const auto& r : tail.getRecords()) {
+            seg.firstDay = std::min(seg.firstDay, r.startDay);
+            seg.lastDay = std::max(seg.lastDay, r.endDay);
+        }
+
+        BinaryWriter out;
+        out.putBytes(magic, sizeof magic);
+        out.putU32(version);
+        tail.write(out);
+        if (!FileIO::writeDurably(directory + seg.file, out.data())) {
+            throw std::runtime_error("Could not write history segment.");
+        }
+        ++nextId;
+        sealedRecords += seg.count;
+        segments.push_back(std::move(seg));
+    }
+
+    /**
+     * @brief Replace the index with the one of loaded state (no files are touched).
+     * @throws std::runtime_error If a segment does not belong to this log.
+     */
+    void assign(std::vector<Segment> index) {
+        sealedRecords = 0;
+        for (const auto& seg : index) {
+            long long id = idOf(seg.file);
+            if (id < 0) throw std::runtime_error("History segment does not belong to the history log.");
+            nextId = std::max(nextId, static_cast<std::uint64_t>(id) + 1);
+            sealedRecords += seg.count;
+        }
+        segments = std::move(index);
+    }
+
+    /**
+     * @brief Render the index in the data file format: "sealed <n>", then one
+     *        "file;count;first day;last day" line per segment (nothing if there are no segments).
+     */
+    void renderIndex(std::ostream& out) const {
+        if (segments.empty()) return;
+        out << "sealed " << segments.size() << "\n";
+        for (const auto& seg : segments) {
+            out << seg.file << ";" << seg.count << ";" << Date::toString(seg.firstDay) << ";"
+                << Date::toString(seg.lastDay) << "\n";
+        }
+    }
+
+    /**
+     * @brief Parse one segment line of the index (see renderIndex).
+     * @throws std::runtime_error If the line is malformed.
+     */
+    static Segment parseIndexLine(std::string_view line) {
+        std::array<std::string_view, 4> fields;
+        Segment seg;
+        int first = 0, last = 0;
+        if (TextReader::split(line, fields) != 4 || fields[0].empty() ||
+            !Date::parse(fields[2], first) || !Date::parse(fields[3], last)) {
+            throw std::runtime_error("Corrupt history index.");
+        }
+        try {
+            int count = TextReader::toInt(fields[1]);
+            if (count <= 0) throw std::invalid_argument("count");
+            seg.count = static_cast<std::uint64_t>(count);
+        } catch (const std::invalid_argument&) {
+            throw std::runtime_error("Corrupt history index.");
+        }
+        seg.file = std::string(fields[0]);
+        seg.firstDay = first;
+        seg.lastDay = last;
+        return seg;
+    }
+
+    /**
+     * @brief Delete the segment files in the log's directory that the index does not reference.
+     * Call only when the index matches the state saved on disk.
+     */
+    void removeUnreferenced() const {
+        std::vector<bool> referenced(nextId, false);
+        for (const auto& seg : segments) referenced[idOf(seg.file)] = true;
+        for (const auto& file : FileIO::listDirectory(directory)) {
+            long long id = idOf(file);
+            if (id < 0) continue;
+            if (static_cast<std::uint64_t>(id) >= nextId || !referenced[id]) std::remove((directory + file).c_str());
+        }
+    }
+
+    /**
+     * @brief Read one segment.
+     * @throws std::runtime_error If the file is missing or corrupt.
+     */
+    void readSegment(const Segment& seg, RentalHistory& out) const {
+        std::string bytes;
+        if (!FileIO::readAll(directory + seg.file, bytes)) throw std::runtime_error("Missing history segment.");
+        BinaryReader in(bytes.data(), bytes.size());
+        for (char c : magic) {
+            if (static_cast<char>(in.getU8()) != c) throw std::runtime_error("Not a history segment.");
+        }
+        if (in.getU32() != version) throw std::runtime_error("Unsupported history segment version.");
+        out.read(in);
+        if (out.size() != seg.count) throw std::runtime_error("Corrupt history segment.");
+    }
+
+    /**
+     * @brief Call f(segmentHistory, record) for every sealed record, oldest first.
+     * Only one segment is in memory at a time.
+     * @param fromDay Segments whose records all end before this day are skipped.
+     */
+    template <typename F>
+    void forEach(F&& f, std::int32_t fromDay = 0) const {
+        RentalHistory part;
+        for (const auto& seg : segments) {
+            if (seg.lastDay < fromDay) continue;
+            readSegment(seg, part);
+            for (const auto& r : part.getRecords()) f(part, r);
+        }
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "Snapshot.hpp"
+#include "FileIO.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace bk {
+
+/**
+ * @class Journal
+ * @brief Append-only log of mutating VehicleManager operations.
+ *
+ * Layout (little-endian):
+ *   magic "BKVJ", u32 version, u64 journal ID,
+ *   entries: u32 body length, u32 body checksum, body (u64 sequence number, u8 Op, payload).
+ * The journal ID ties the journal to the state it was started on (the hash
+ * of a data file, or the ID kept in a checkpoint manifest), so a journal
+ * left over from an older base is ignored instead of being applied twice.
+ * Sequence numbers grow by one per entry; a checkpoint records the last one
+ * it contains and replay skips entries up to it. Replay stops at the first
+ * truncated or corrupt entry (a torn write at crash time).
+ *
+ * Appends only copy the entry into a buffer. A writer thread collects the
+ * entries appended during one commit interval and makes them durable with a
+ * single write + fsync (group commit), so at most one interval of operations
+ * is lost on a crash. flush() waits for everything appended so far.
+ */
+class Journal {
+public:
+    /**
+     * @brief Journaled operations.
+     */
+    enum class Op : std::uint8_t {
+        AddVehicle = 1,  ///< Vehicle record (Snapshot format)
+        RemoveVehicle,   ///< Registration number
+        AddCustomer,     ///< Customer record (Snapshot format)
+        RemoveCustomer,  ///< Customer ID
+        Rent,            ///< Registration number, customer ID, start date, end date
+        Return,          ///< Registration number, new mileage
+        Reserve,         ///< Registration number, customer ID, start date, end date
+        CancelReservation, ///< Registration number, start date
+        Service,         ///< Registration number, u8 MaintenanceSchedule::Task
+        ServiceInterval, ///< u8 MaintenanceSchedule::Task, km between services
+        UpdateVehicle,   ///< Vehicle record (Snapshot format) after a setter changed it
+        SetEndDate       ///< Registration number, new end date of the active rental
+    };
+
+    /**
+     * @brief Outcome of replay().
+     */
+    struct ReplayResult {
+        std::size_t validLength = 0; ///< Length of the valid prefix (0 if the journal does not apply)
+        std::uint64_t lastSequence = 0; ///< Highest sequence number found
+    };
+
+    static constexpr char magic[4] = {'B', 'K', 'V', 'J'};
+    static constexpr std::uint32_t version = 2;
+    static constexpr std::size_t headerSize = 16;
+
+private:
+    std::string path;               ///< Journal file
+    std::uint64_t journalId;        ///< ID written in the header
+    int fd = -1;                    ///< Journal file descriptor
+    std::chrono::milliseconds commitInterval;
+    std::string pending;            ///< Framed entries not written yet
+    std::uint64_t nextSequence;     ///< Sequence number of the next entry
+    std::uint64_t appended = 0;     ///< Entries appended so far
+    std::uint64_t durable = 0;      ///< Entries written and synced
+    bool flushRequested = false;    ///< A caller waits in flush()
+    bool stopping = false;
+    bool failed = false;            ///< A write or sync failed
+    std::mutex mutex;               ///< Guards the fields above except fd
+    std::mutex ioMutex;             ///< Guards fd and the file contents
+    std::condition_variable wakeWriter;  ///< New entries, flush or stop
+    std::condition_variable wakeWaiters; ///< durable advanced or failure
+    std::thread writer;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wakeWriter.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return; // stopping and drained
+            // Let more entries join this commit
+            wakeWriter.wait_for(lock, commitInterval, [this] { return stopping || flushRequested; });
+
+            std::string batch;
+            batch.swap(pending);
+            std::uint64_t batchEnd = appended;
+            flushRequested = false;
+            lock.unlock();
+            bool ok;
+            {
+                std::lock_guard<std::mutex> io(ioMutex);
+                ok = FileIO::writeAll(fd, batch.data(), batch.size()) && FileIO::sync(fd);
+            }
+            lock.lock();
+            if (ok) {
+                durable = batchEnd;
+            } else {
+                failed = true;
+            }
+            wakeWaiters.notify_all();
+        }
+    }
+
+    static std::string header(std::uint64_t id) {
+        BinaryWriter out;
+        out.putBytes(magic, sizeof magic);
+        out.putU32(version);
+        out.putU64(id);
+        return out.data();
+    }
+
+    /**
+     * @brief Call f(sequence, body) for every valid entry of a journal image.
+     * @return Length of the valid prefix.
+     */
+    template <typename F>
+    static std::size_t forEachEntry(const std::string& bytes, F&& f) {
+        BinaryReader in(bytes.data() + headerSize, bytes.size() - headerSize);
+        std::size_t valid = headerSize;
+        while (in.remaining() >= 8) {
+            std::uint32_t len = in.getU32();
+            std::uint32_t sum = in.getU32();
+            if (len < 9 || in.remaining() < len) break;
+            std::string_view body(in.position(), len);
+            if (static_cast<std::uint32_t>(hashOf(body)) != sum) break;
+            BinaryReader entry(body.data(), body.size());
+            std::uint64_t sequence = entry.getU64();
+            f(sequence, entry, std::string_view(in.position() - 8, len + 8));
+            in.skip(len);
+            valid += 8 + len;
+        }
+        return valid;
+    }
+
+public:
+    /**
+     * @brief Open a journal for appending.
+     * @param filename Path to the journal file (created if missing).
+     * @param id Journal ID (see class description).
+     * @param previous Result of replaying the existing file; a zero validLength
+     *        starts a new, empty journal.
+     * @param interval Group commit interval.
+     * @throws std::runtime_error If the file cannot be opened or written.
+     */
+    Journal(const std::string& filename, std::uint64_t id, const ReplayResult& previous,
+            std::chrono::milliseconds interval = std::chrono::milliseconds(5))
+        : path(filename), journalId(id), commitInterval(interval), nextSequence(previous.lastSequence + 1) {
+        fd = FileIO::openForWrite(filename);
+        if (fd < 0) throw std::runtime_error("Could not open journal.");
+        bool ok = FileIO::truncate(fd, previous.validLength);
+        if (ok && previous.validLength == 0) {
+            std::string head = header(id);
+            ok = FileIO::writeAll(fd, head.data(), head.size()) && FileIO::sync(fd);
+        }
+        if (!ok) {
+            FileIO::close(fd);
+            throw std::runtime_error("Could not write journal.");
+        }
+        writer = std::thread([this] { run(); });
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    /**
+     * @brief Write the remaining entries and close the file.
+     */
+    ~Journal() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWriter.notify_one();
+        writer.join();
+        if (fd >= 0) FileIO::close(fd);
+    }
+
+    /**
+     * @brief FNV-1a hash used for data file hashes and entry checksums.
+     */
+    static std::uint64_t hashOf(std::string_view bytes) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char ch : bytes) {
+            h ^= ch;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    /**
+     * @brief Hash of a file's contents (hash of no bytes if it does not exist).
+     */
+    static std::uint64_t hashOfFile(const std::string& filename) {
+        std::string bytes;
+        FileIO::readAll(filename, bytes);
+        return hashOf(bytes);
+    }
+
+    std::uint64_t getId() const { return journalId; }
+
+    /**
+     * @brief Sequence number of the last appended entry (0 if none).
+     */
+    std::uint64_t lastSequence() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return nextSequence - 1;
+    }
+
+    /**
+     * @brief Queue an entry.
+     * @param body u8 Op followed by its payload.
+     * @throws std::runtime_error If an earlier write failed.
+     */
+    void append(std::string_view body) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failed) throw std::runtime_error("Journal write failed.");
+        BinaryWriter frame;
+        frame.putU64(nextSequence++);
+        frame.putBytes(body.data(), body.size());
+        const std::string& full = frame.data();
+        BinaryWriter prefix;
+        prefix.putU32(static_cast<std::uint32_t>(full.size()));
+        prefix.putU32(static_cast<std::uint32_t>(hashOf(full)));
+        pending += prefix.data();
+        pending += full;
+        ++appended;
+        wakeWriter.notify_one();
+    }
+
+    /**
+     * @brief Wait until every appended entry is durable.
+     * @throws std::runtime_error If a write failed.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::uint64_t target = appended;
+        flushRequested = true;
+        wakeWriter.notify_one();
+        wakeWaiters.wait(lock, [&] { return durable >= target || failed; });
+        if (failed) throw std::runtime_error("Journal write failed.");
+    }
+
+    /**
+     * @brief Drop all entries and start over on a new base.
+     * Only for callers that append from the same thread (nothing may be appended concurrently).
+     * @param id New journal ID.
+     */
+    void reset(std::uint64_t id) {
+        flush();
+        std::lock_guard<std::mutex> io(ioMutex);
+        journalId = id;
+        std::string head = header(id);
+        if (!FileIO::truncate(fd, 0) || !FileIO::writeAll(fd, head.data(), head.size()) || !FileIO::sync(fd)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            throw std::runtime_error("Journal write failed.");
+        }
+    }
+
+    /**
+     * @brief Drop the entries up to a sequence number, keeping later ones.
+     *
+     * The file is rewritten to a temporary file and renamed over the journal,
+     * which is closed during the rename and reopened. Safe to call while other
+     * threads append: entries not yet written go to the new file.
+     * @throws std::runtime_error If the journal cannot be rewritten.
+     */
+    void compact(std::uint64_t upToSequence) {
+        std::lock_guard<std::mutex> io(ioMutex);
+        std::string bytes;
+        if (!FileIO::readAll(path, bytes) || bytes.size() < headerSize) {
+            throw std::runtime_error("Could not read journal.");
+        }
+        std::string kept = bytes.substr(0, headerSize);
+        forEachEntry(bytes, [&](std::uint64_t sequence, BinaryReader&, std::string_view frame) {
+            if (sequence > upToSequence) kept.append(frame.data(), frame.size());
+        });
+
+        const std::string tmpName = path + ".tmp";
+        if (!FileIO::writeDurably(tmpName, kept)) throw std::runtime_error("Could not write journal.");
+        // Windows cannot rename over a file that is open, so the journal is reopened afterwards
+        FileIO::close(fd);
+        bool replaced = FileIO::replace(tmpName, path);
+        if (!replaced) std::remove(tmpName.c_str());
+        fd = FileIO::openForWrite(path);
+        if (fd < 0 || !FileIO::truncate(fd, replaced ? kept.size() : bytes.size())) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+            throw std::runtime_error("Could not reopen journal.");
+        }
+        if (!replaced) throw std::runtime_error("Could not write journal.");
+    }
+
+    /**
+     * @brief Read the entries of a journal that belongs to the given base.
+     * @param id Expected journal ID.
+     * @param afterSequence Entries up to this sequence number are skipped (already in the base).
+     * @param apply Called as apply(Op, BinaryReader& payload) for every other entry in order.
+     */
+    template <typename F>
+    static ReplayResult replay(const std::string& filename, std::uint64_t id, std::uint64_t afterSequence,
+                               F&& apply) {
+        ReplayResult result;
+        result.lastSequence = afterSequence;
+        std::string bytes;
+        if (!FileIO::readAll(filename, bytes)) return result;
+        if (bytes.size() < headerSize || bytes.compare(0, headerSize, header(id)) != 0) return result;
+
+        result.validLength = forEachEntry(bytes, [&](std::uint64_t sequence, BinaryReader& entry, std::string_view) {
+            if (sequence <= afterSequence) return;
+            result.lastSequence = sequence;
+            apply(static_cast<Op>(entry.getU8()), entry);
+        });
+        return result;
+    }
+};
+
+} // namespace bk
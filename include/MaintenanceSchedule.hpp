@@ -0,0 +1,239 @@
+#pragma once
+
+#include "Vehicle.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class MaintenanceSchedule
+ * @brief Mileage-based service tracking of the fleet by vehicle slot.
+ *
+ * Every vehicle has the service tasks of its type: an oil change for
+ * combustion vehicles, a battery check for electric cars and, for trucks,
+ * an inspection on top of the oil change. A task is due again after its
+ * interval in km since it was last done. A vehicle that has never been
+ * serviced counts from the mileage it was added with.
+ *
+ * Vehicles are kept in an ordered set keyed by km to their next service
+ * (the smallest over their tasks), so a mileage change or a service is
+ * O(log n) and the vehicles due for service are the front of the set.
+ */
+class MaintenanceSchedule {
+public:
+    /**
+     * @enum Task
+     * @brief Kind of service.
+     */
+    enum class Task {
+        OilChange,    ///< Combustion vehicles
+        BatteryCheck, ///< Electric vehicles
+        Inspection    ///< Trucks
+    };
+
+    static constexpr int taskCount = 3; ///< Number of Task values
+
+    /**
+     * @brief Default km between two services of a task.
+     */
+    static constexpr std::array<double, taskCount> defaultIntervals = {15000.0, 30000.0, 40000.0};
+
+    /**
+     * @brief Name of a task in the data file.
+     */
+    static const char* taskName(Task task) {
+        static const char* const names[taskCount] = {"oil", "battery", "inspection"};
+        return names[static_cast<int>(task)];
+    }
+
+    /**
+     * @brief Parse a task name (see taskName).
+     * @return false if the name is unknown.
+     */
+    static bool parseTask(std::string_view name, Task& task) {
+        for (int t = 0; t < taskCount; ++t) {
+            if (name == taskName(static_cast<Task>(t))) {
+                task = static_cast<Task>(t);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check whether vehicles of a kind need a task.
+     */
+    static constexpr bool appliesTo(Vehicle::VehicleKind kind, Task task) {
+        switch (task) {
+            case Task::OilChange: return kind != Vehicle::VehicleKind::ElectricCar;
+            case Task::BatteryCheck: return kind == Vehicle::VehicleKind::ElectricCar;
+            case Task::Inspection: return kind == Vehicle::VehicleKind::Truck;
+        }
+        return false;
+    }
+
+private:
+    struct Entry {
+        std::array<double, taskCount> lastService{}; ///< Mileage at the last service per task
+        double mileage = 0.0;
+        double remaining = 0.0;  ///< Km to the next service (key in bySchedule)
+        Vehicle::VehicleKind kind = Vehicle::VehicleKind::CombustionCar;
+        bool used = false;
+    };
+
+    std::vector<Entry> entries; ///< Slot ID -> service state
+    std::set<std::pair<double, std::size_t>> bySchedule; ///< (km to next service, slot), soonest first
+    std::array<double, taskCount> intervals = defaultIntervals;
+
+    double remainingOf(const Entry& e) const {
+        double least = std::numeric_limits<double>::infinity();
+        for (int t = 0; t < taskCount; ++t) {
+            if (!appliesTo(e.kind, static_cast<Task>(t))) continue;
+            least = std::min(least, e.lastService[t] + intervals[t] - e.mileage);
+        }
+        return least;
+    }
+
+    /**
+     * @brief Move a slot to its current key.
+     */
+    void reschedule(std::size_t slot) {
+        Entry& e = entries[slot];
+        double next = remainingOf(e);
+        if (next == e.remaining) return;
+        bySchedule.erase({e.remaining, slot});
+        e.remaining = next;
+        bySchedule.emplace(next, slot);
+    }
+
+    const Entry& at(std::size_t slot) const {
+        if (!contains(slot)) throw std::invalid_argument("Vehicle is not scheduled for maintenance.");
+        return entries[slot];
+    }
+
+    static void checkTask(Vehicle::VehicleKind kind, Task task) {
+        if (!appliesTo(kind, task)) throw std::invalid_argument("Service does not apply to this vehicle type.");
+    }
+
+public:
+    bool contains(std::size_t slot) const { return slot < entries.size() && entries[slot].used; }
+
+    /**
+     * @brief Start tracking a vehicle; every task counts from the given mileage.
+     */
+    void add(std::size_t slot, Vehicle::VehicleKind kind, double mileage) {
+        if (slot >= entries.size()) entries.resize(slot + 1);
+        Entry& e = entries[slot];
+        if (e.used) bySchedule.erase({e.remaining, slot});
+        e.lastService.fill(mileage);
+        e.mileage = mileage;
+        e.kind = kind;
+        e.used = true;
+        e.remaining = remainingOf(e);
+        bySchedule.emplace(e.remaining, slot);
+    }
+
+    /**
+     * @brief Stop tracking a vehicle (no-op if it is not tracked).
+     */
+    void remove(std::size_t slot) {
+        if (!contains(slot)) return;
+        bySchedule.erase({entries[slot].remaining, slot});
+        entries[slot].used = false;
+    }
+
+    /**
+     * @brief Update the mileage of a tracked vehicle.
+     */
+    void setMileage(std::size_t slot, double mileage) {
+        if (!contains(slot)) return;
+        entries[slot].mileage = mileage;
+        reschedule(slot);
+    }
+
+    /**
+     * @brief Record that a task was done at the vehicle's current mileage.
+     * @throws std::invalid_argument If the vehicle is not tracked or the task does not apply.
+     */
+    void service(std::size_t slot, Task task) {
+        const Entry& e = at(slot);
+        setLastService(slot, task, e.mileage);
+    }
+
+    /**
+     * @brief Set the mileage at which a task was last done (used when loading).
+     * @throws std::invalid_argument If the vehicle is not tracked, the task does not apply or
+     *         the mileage is not finite.
+     */
+    void setLastService(std::size_t slot, Task task, double mileage) {
+        checkTask(at(slot).kind, task);
+        if (!std::isfinite(mileage)) throw std::invalid_argument("Service mileage must be a finite number.");
+        entries[slot].lastService[static_cast<int>(task)] = mileage;
+        reschedule(slot);
+    }
+
+    /**
+     * @brief Mileage at which a task was last done.
+     * @throws std::invalid_argument If the vehicle is not tracked or the task does not apply.
+     */
+    double getLastService(std::size_t slot, Task task) const {
+        const Entry& e = at(slot);
+        checkTask(e.kind, task);
+        return e.lastService[static_cast<int>(task)];
+    }
+
+    /**
+     * @brief Km until the vehicle's next service (zero or negative if it is due).
+     * @throws std::invalid_argument If the vehicle is not tracked.
+     */
+    double kmToService(std::size_t slot) const { return at(slot).remaining; }
+
+    bool isDue(std::size_t slot) const { return contains(slot) && entries[slot].remaining <= 0.0; }
+
+    /**
+     * @brief Call f(slot, kmToService) for the vehicles due within a distance, soonest first.
+     * @param km 0 for the vehicles that are due now.
+     */
+    template <typename F>
+    void forEachDueWithin(double km, F&& f) const {
+        for (const auto& [remaining, slot] : bySchedule) {
+            if (remaining > km) break;
+            f(slot, remaining);
+        }
+    }
+
+    /**
+     * @brief Set the km between two services of a task (reschedules every vehicle).
+     * @throws std::invalid_argument If the interval is not positive.
+     */
+    void setInterval(Task task, double km) {
+        if (!(km > 0.0)) throw std::invalid_argument("Service interval must be positive.");
+        intervals[static_cast<int>(task)] = km;
+        for (std::size_t slot = 0; slot < entries.size(); ++slot) {
+            if (entries[slot].used) reschedule(slot);
+        }
+    }
+
+    double getInterval(Task task) const { return intervals[static_cast<int>(task)]; }
+
+    /**
+     * @brief Stop tracking every vehicle and restore the default intervals.
+     */
+    void clear() {
+        entries.clear();
+        bySchedule.clear();
+        intervals = defaultIntervals;
+    }
+};
+
+} // namespace bk
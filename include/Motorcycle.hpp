@@ -78,6 +78,14 @@ public:
     MainVehicleType getMainVehicleType() const override {
         return MainVehicleType::Motorcycle;
     }
+
+    /**
+     * @brief Get the concrete vehicle kind.
+     * @return VehicleKind enum value.
+     */
+    VehicleKind getKind() const override {
+        return VehicleKind::Motorcycle;
+    }
 };
 
 } // namespace bk
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <utility>
+
+namespace bk {
+
+/**
+ * @class PriceIndex
+ * @brief Ordered index of (base cost, slot ID) pairs.
+ *
+ * Updates are O(log n). Range queries and cheapest/most expensive walks visit
+ * entries in price order (ties ordered by slot ID), so they cost
+ * O(log n + visited entries).
+ */
+class PriceIndex {
+private:
+    std::set<std::pair<double, std::size_t>> entries; ///< Sorted by cost, then slot
+
+public:
+    void insert(double cost, std::size_t slot) { entries.emplace(cost, slot); }
+    void erase(double cost, std::size_t slot) { entries.erase({cost, slot}); }
+
+    /**
+     * @brief Move a slot to a new cost.
+     */
+    void update(double oldCost, double newCost, std::size_t slot) {
+        erase(oldCost, slot);
+        insert(newCost, slot);
+    }
+
+    void clear() { entries.clear(); }
+    std::size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Visit slots with cost in [minCost, maxCost] in ascending order.
+     * @param f Called as f(slot); returning false stops the walk.
+     */
+    template <typename F>
+    void forEachInRange(double minCost, double maxCost, F&& f) const {
+        for (auto it = entries.lower_bound({minCost, 0}); it != entries.end() && it->first <= maxCost; ++it) {
+            if (!f(it->second)) return;
+        }
+    }
+
+    /**
+     * @brief Visit slots from the most expensive down, starting at maxCost.
+     * @param f Called as f(slot); returning false stops the walk.
+     */
+    template <typename F>
+    void forEachDescending(double maxCost, F&& f) const {
+        auto it = entries.upper_bound({maxCost, static_cast<std::size_t>(-1)});
+        while (it != entries.begin()) {
+            --it;
+            if (!f(it->second)) return;
+        }
+    }
+};
+
+} // namespace bk
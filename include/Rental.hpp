@@ -2,12 +2,30 @@
 
 #include "Vehicle.hpp"
 #include "Customer.hpp"
+#include "Date.hpp"
 #include <string>
 #include <stdexcept>
 #include <sstream>
 
 namespace bk {
 
+class Rental;
+
+/**
+ * @class RentalObserver
+ * @brief Interface notified when a rental's end date changes.
+ */
+class RentalObserver {
+public:
+    virtual ~RentalObserver() = default;
+
+    /**
+     * @brief Called after setEndDate() changed the rental.
+     * @param r The changed rental.
+     */
+    virtual void onRentalChanged(const Rental& r) = 0;
+};
+
 /**
  * @class Rental
  * @brief Represents a rental transaction linking a Vehicle and a Customer.
@@ -18,54 +36,23 @@ private:
     Customer* customer; ///< Customer renting the vehicle (Raw pointer)
     std::string startDate; ///< Start date of rental
     std::string endDate;   ///< End date of rental
-
-    /**
-     * @brief Helper to check if a year is a leap year.
-     */
-    static bool isLeapYear(int year) {
-        return ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0));
-    }
-
-    /**
-     * @brief Get number of days in a specific month of a specific year.
-     */
-    static int getDaysInMonth(int month, int year) {
-        // Index 0 = January, 1 = February, etc.
-        static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-        if (month < 1 || month > 12) return 0;
-        
-        int d = days[month - 1];
-        if (month == 2 && isLeapYear(year)) d++;
-        return d;
-    }
+    int startDay;          ///< Start date as a Date day number (parsed once)
+    int endDay;            ///< End date as a Date day number (parsed once)
+    RentalObserver* observer = nullptr; ///< Notified on changes (not owned)
 
 public:
     /**
      * @brief Helper to validate date format "YYYY-MM-DD".
      */
     static bool isValidDate(const std::string& date) {
-        if (date.length() != 10) return false;
-        if (date[4] != '-' || date[7] != '-') return false;
-        for (int i = 0; i < 10; ++i) {
-            if (i == 4 || i == 7) continue;
-            if (!isdigit(date[i])) return false;
-        }
-        
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-        
-        if (month < 1 || month > 12) return false;
-        
-        if (day < 1 || day > getDaysInMonth(month, year)) return false;
-
-        return true;
+        int day = 0;
+        return Date::parse(date, day);
     }
 
     /**
      * @brief Default Constructor.
      */
-    Rental() : vehicle(nullptr), customer(nullptr), startDate(""), endDate("") {}
+    Rental() : vehicle(nullptr), customer(nullptr), startDate(""), endDate(""), startDay(0), endDay(0) {}
 
     /**
      * @brief Parametric Constructor.
@@ -76,15 +63,15 @@ public:
      * @throws std::invalid_argument If pointers are null, dates empty/invalid, or end <= start.
      */
     Rental(Vehicle* v, Customer* c, const std::string& start, const std::string& end)
-        : vehicle(v), customer(c), startDate(start), endDate(end)
+        : vehicle(v), customer(c), startDate(start), endDate(end), startDay(0), endDay(0)
     {
         if (v == nullptr) throw std::invalid_argument("Vehicle cannot be null.");
         if (c == nullptr) throw std::invalid_argument("Customer cannot be null.");
         
-        if (!isValidDate(start)) throw std::invalid_argument("Start date must be in format YYYY-MM-DD.");
-        if (!isValidDate(end)) throw std::invalid_argument("End date must be in format YYYY-MM-DD.");
+        if (!Date::parse(start, startDay)) throw std::invalid_argument("Start date must be in format YYYY-MM-DD.");
+        if (!Date::parse(end, endDay)) throw std::invalid_argument("End date must be in format YYYY-MM-DD.");
 
-        if (end <= startDate) {
+        if (endDay <= startDay) {
             throw std::invalid_argument("End date must be later than start date.");
         }
     }
@@ -93,11 +80,19 @@ public:
      * @brief End the rental (update end date).
      */
     void setEndDate(const std::string& end) {
-         if (!isValidDate(end)) throw std::invalid_argument("End date must be in format YYYY-MM-DD.");
-         if (end <= startDate) throw std::invalid_argument("End date must be later than start date.");
+         int day = 0;
+         if (!Date::parse(end, day)) throw std::invalid_argument("End date must be in format YYYY-MM-DD.");
+         if (day <= startDay) throw std::invalid_argument("End date must be later than start date.");
          endDate = end;
+         endDay = day;
+         if (observer) observer->onRentalChanged(*this);
     }
 
+    /**
+     * @brief Set the observer notified by setEndDate() (nullptr to detach).
+     */
+    void setObserver(RentalObserver* obs) { observer = obs; }
+
     /**
      * @brief Get the rented vehicle.
      * @return Raw pointer to vehicle.
@@ -112,37 +107,32 @@ public:
 
     /**
      * @brief Get the start date.
-     * @return Start date string.
+     * @return Reference to the start date string.
      */
-    std::string getStartDate() const { return startDate; }
+    const std::string& getStartDate() const { return startDate; }
 
     /**
      * @brief Get the end date.
-     * @return End date string.
+     * @return Reference to the end date string.
      */
-    std::string getEndDate() const { return endDate; }
+    const std::string& getEndDate() const { return endDate; }
 
     /**
-     * @brief Calculate total days since year 0 to the given date.
+     * @brief Get the start date as a Date day number.
      */
-    int countTotalDays(const std::string& date) const {
-        int y = std::stoi(date.substr(0, 4));
-        int m = std::stoi(date.substr(5, 2));
-        int d = std::stoi(date.substr(8, 2));
-
-        int total = d; // Add current month days
+    int getStartDay() const { return startDay; }
 
-        // Add days for past years
-        for (int i = 1; i < y; ++i) {
-            total += isLeapYear(i) ? 366 : 365;
-        }
+    /**
+     * @brief Get the end date as a Date day number.
+     */
+    int getEndDay() const { return endDay; }
 
-        // Add days for past months in current year
-        for (int i = 1; i < m; ++i) {
-            total += getDaysInMonth(i, y);
-        }
-        
-        return total;
+    /**
+     * @brief Calculate total days since year 0 to the given date.
+     * @throws std::invalid_argument If the date is not valid.
+     */
+    int countTotalDays(const std::string& date) const {
+        return Date::toDayNumber(date);
     }
 
     /**
@@ -151,9 +141,7 @@ public:
      */
     int getRentalDays() const {
         if (startDate.empty() || endDate.empty()) return 0;
-        int startTotal = countTotalDays(startDate);
-        int endTotal = countTotalDays(endDate);
-        int days = endTotal - startTotal;
+        int days = endDay - startDay;
         return (days < 1) ? 1 : days; 
     }
 
@@ -0,0 +1,397 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "Customer.hpp"
+#include "Date.hpp"
+#include "HashIndex.hpp"
+#include "Snapshot.hpp"
+#include "TextReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @brief One completed rental.
+ */
+struct HistoryRecord {
+    std::uint32_t vehicle = 0;   ///< Index of the vehicle in RentalHistory::getVehicles()
+    std::uint32_t customer = 0;  ///< Index of the customer in RentalHistory::getCustomers()
+    std::int32_t startDay = 0;   ///< Start date as a Date day number
+    std::int32_t endDay = 0;     ///< End date as a Date day number
+    std::int64_t costGrosze = 0; ///< Total cost in grosze (1/100 zl)
+
+    double getCost() const { return static_cast<double>(costGrosze) / 100.0; }
+};
+
+/**
+ * @class RentalHistory
+ * @brief Archive of completed rentals as fixed-size records.
+ *
+ * Vehicles and customers are interned: each distinct vehicle (registration
+ * number, brand, model) and customer (ID, name) is stored once, with its
+ * display label, and records refer to it by index. Interned entries outlive
+ * removal of the vehicle or customer, so history keeps rendering the same.
+ * The text form "Brand Model (REG);Name (ID);start;end;cost;kind;type" is
+ * produced for the data file and parsed when loading it; kind and type are
+ * the VehicleKind and CustomerType as integers (empty if unknown). Lines of
+ * older files end after the cost.
+ */
+class RentalHistory {
+public:
+    static constexpr std::uint8_t unknown = 0xFF; ///< kind/type of entries parsed from text without a match
+
+    /**
+     * @brief Interned vehicle.
+     */
+    struct VehicleEntry {
+        std::string regNumber;
+        std::string brand;
+        std::string model;
+        std::uint8_t kind = unknown; ///< VehicleKind as integer
+        std::string label;           ///< "Brand Model (REG)"
+    };
+
+    /**
+     * @brief Interned customer.
+     */
+    struct CustomerEntry {
+        std::string id;
+        std::string name;
+        std::uint8_t type = unknown; ///< CustomerType as integer
+        std::string label;           ///< "Name (ID)"
+    };
+
+    /**
+     * @brief Current fields of a vehicle, used to recover its entry from the text form.
+     */
+    struct VehicleInfo {
+        std::string_view brand;
+        std::string_view model;
+        std::uint8_t kind = unknown;
+    };
+
+    /**
+     * @brief Current fields of a customer, used to recover its entry from the text form.
+     */
+    struct CustomerInfo {
+        std::string_view name;
+        std::uint8_t type = unknown;
+    };
+
+private:
+    std::vector<HistoryRecord> records;
+    std::vector<VehicleEntry> vehicles;
+    std::vector<CustomerEntry> customers;
+    HashIndex<std::uint32_t> vehicleByReg;  ///< Registration number -> newest entry
+    HashIndex<std::uint32_t> customerById;  ///< Customer ID -> newest entry
+
+    /**
+     * @brief Split "Name (KEY)" into name and key.
+     * @return false if the label has no trailing "(KEY)".
+     */
+    static bool splitLabel(std::string_view label, std::string_view& name, std::string_view& key) {
+        std::size_t open = label.rfind(" (");
+        if (open == std::string_view::npos || label.empty() || label.back() != ')') return false;
+        name = label.substr(0, open);
+        key = label.substr(open + 2, label.size() - open - 3);
+        return true;
+    }
+
+    std::uint32_t addVehicle(VehicleEntry entry) {
+        auto index = static_cast<std::uint32_t>(vehicles.size());
+        auto* newest = vehicleByReg.find(entry.regNumber);
+        if (newest) {
+            *newest = index;
+        } else {
+            vehicleByReg.insert(entry.regNumber, index);
+        }
+        vehicles.push_back(std::move(entry));
+        return index;
+    }
+
+    std::uint32_t addCustomer(CustomerEntry entry) {
+        auto index = static_cast<std::uint32_t>(customers.size());
+        auto* newest = customerById.find(entry.id);
+        if (newest) {
+            *newest = index;
+        } else {
+            customerById.insert(entry.id, index);
+        }
+        customers.push_back(std::move(entry));
+        return index;
+    }
+
+    /**
+     * @brief Parse an optional kind/type field of the text form.
+     * @return The value, or unknown if the field is empty or out of range.
+     */
+    static std::uint8_t parseCode(std::string_view field, int count) {
+        if (field.empty()) return unknown;
+        try {
+            int code = TextReader::toInt(field);
+            return code >= 0 && code < count ? static_cast<std::uint8_t>(code) : unknown;
+        } catch (const std::invalid_argument&) {
+            return unknown;
+        }
+    }
+
+    static void putCode(std::ostream& out, std::uint8_t code) {
+        if (code != unknown) out << static_cast<int>(code);
+    }
+
+public:
+    /**
+     * @brief Get the entry of a vehicle, adding it on first use.
+     */
+    std::uint32_t internVehicle(const Vehicle& v) {
+        return internVehicle(v.getRegNumber(), {v.getBrand(), v.getModel(), static_cast<std::uint8_t>(v.getKind())});
+    }
+
+    /**
+     * @brief Get the entry of a vehicle given by its fields, adding it on first use.
+     */
+    std::uint32_t internVehicle(std::string_view regNumber, const VehicleInfo& v) {
+        auto* newest = vehicleByReg.find(regNumber);
+        if (newest) {
+            VehicleEntry& e = vehicles[*newest];
+            if (e.brand == v.brand && e.model == v.model) {
+                if (v.kind != unknown) e.kind = v.kind;
+                return *newest;
+            }
+        }
+        VehicleEntry e;
+        e.regNumber = std::string(regNumber);
+        e.brand = std::string(v.brand);
+        e.model = std::string(v.model);
+        e.kind = v.kind;
+        e.label = e.brand + " " + e.model + " (" + e.regNumber + ")";
+        return addVehicle(std::move(e));
+    }
+
+    /**
+     * @brief Get the entry of a customer, adding it on first use.
+     */
+    std::uint32_t internCustomer(const Customer& c) {
+        return internCustomer(c.getId(), {c.getName(), static_cast<std::uint8_t>(c.getType())});
+    }
+
+    /**
+     * @brief Get the entry of a customer given by its fields, adding it on first use.
+     */
+    std::uint32_t internCustomer(std::string_view id, const CustomerInfo& c) {
+        auto* newest = customerById.find(id);
+        if (newest) {
+            CustomerEntry& e = customers[*newest];
+            if (e.name == c.name) {
+                if (c.type != unknown) e.type = c.type;
+                return *newest;
+            }
+        }
+        CustomerEntry e;
+        e.id = std::string(id);
+        e.name = std::string(c.name);
+        e.type = c.type;
+        e.label = e.name + " (" + e.id + ")";
+        return addCustomer(std::move(e));
+    }
+
+    /**
+     * @brief Append a record.
+     */
+    void add(const HistoryRecord& r) { records.push_back(r); }
+
+    /**
+     * @brief Parse a line of the text form and append it.
+     * @param findVehicle Called as findVehicle(regNumber), returns the current vehicle's
+     *        std::optional<VehicleInfo>. Used to recover brand and model when they match the
+     *        label, and the kind if the line has none.
+     * @param findCustomer Called as findCustomer(id), returns the current customer's
+     *        std::optional<CustomerInfo>.
+     * @return false if the line is malformed (nothing is added).
+     */
+    template <typename FindVehicle, typename FindCustomer>
+    bool addLine(std::string_view line, FindVehicle&& findVehicle, FindCustomer&& findCustomer) {
+        std::array<std::string_view, 7> parts;
+        std::size_t fieldCount = TextReader::split(line, parts);
+        if (fieldCount < 5) return false;
+        std::uint8_t kind = fieldCount > 5 ? parseCode(parts[5], Vehicle::kindCount) : unknown;
+        std::uint8_t type = fieldCount > 6 ? parseCode(parts[6], customerTypeCount) : unknown;
+
+        std::string_view brandModel, reg, name, id;
+        if (!splitLabel(parts[0], brandModel, reg) || !splitLabel(parts[1], name, id)) return false;
+        HistoryRecord r;
+        int start = 0, end = 0;
+        if (!Date::parse(parts[2], start) || !Date::parse(parts[3], end)) return false;
+        r.startDay = start;
+        r.endDay = end;
+        try {
+            r.costGrosze = std::llround(TextReader::toDouble(parts[4]) * 100.0);
+        } catch (const std::invalid_argument&) {
+            return false;
+        }
+
+        std::optional<VehicleInfo> v = findVehicle(reg);
+        auto* knownVehicle = vehicleByReg.find(reg);
+        if (v && brandModel.size() == v->brand.size() + 1 + v->model.size() &&
+            brandModel.substr(0, v->brand.size()) == v->brand && brandModel[v->brand.size()] == ' ' &&
+            brandModel.substr(v->brand.size() + 1) == v->model) {
+            if (kind != unknown) v->kind = kind;
+            r.vehicle = internVehicle(reg, *v);
+        } else if (knownVehicle && vehicles[*knownVehicle].label == parts[0]) {
+            r.vehicle = *knownVehicle;
+            if (kind != unknown) vehicles[r.vehicle].kind = kind;
+        } else {
+            VehicleEntry e;
+            e.regNumber = std::string(reg);
+            std::size_t space = brandModel.find(' ');
+            e.brand = std::string(brandModel.substr(0, space));
+            if (space != std::string_view::npos) e.model = std::string(brandModel.substr(space + 1));
+            e.kind = kind;
+            e.label = std::string(parts[0]);
+            r.vehicle = addVehicle(std::move(e));
+        }
+
+        std::optional<CustomerInfo> c = findCustomer(id);
+        auto* knownCustomer = customerById.find(id);
+        if (c && c->name == name) {
+            if (type != unknown) c->type = type;
+            r.customer = internCustomer(id, *c);
+        } else if (knownCustomer && customers[*knownCustomer].label == parts[1]) {
+            r.customer = *knownCustomer;
+            if (type != unknown) customers[r.customer].type = type;
+        } else {
+            CustomerEntry e;
+            e.id = std::string(id);
+            e.name = std::string(name);
+            e.type = type;
+            e.label = std::string(parts[1]);
+            r.customer = addCustomer(std::move(e));
+        }
+
+        records.push_back(r);
+        return true;
+    }
+
+    /**
+     * @brief Render a record in the text form (the cost exactly, with two decimals).
+     */
+    std::string toText(const HistoryRecord& r) const {
+        std::ostringstream out;
+        std::uint64_t grosze = r.costGrosze < 0 ? 0 - static_cast<std::uint64_t>(r.costGrosze)
+                                                : static_cast<std::uint64_t>(r.costGrosze);
+        out << vehicles[r.vehicle].label << ";" << customers[r.customer].label << ";"
+            << Date::toString(r.startDay) << ";" << Date::toString(r.endDay) << ";"
+            << (r.costGrosze < 0 ? "-" : "") << grosze / 100 << "." << std::setw(2) << std::setfill('0')
+            << grosze % 100 << ";";
+        putCode(out, vehicles[r.vehicle].kind);
+        out << ";";
+        putCode(out, customers[r.customer].type);
+        return out.str();
+    }
+
+    /**
+     * @brief Encode the entries and records.
+     *
+     * Layout: u32 vehicle count, entries (reg, brand, model, u8 kind, label),
+     * u32 customer count, entries (ID, name, u8 type, label),
+     * u32 record count, records (u32 vehicle, u32 customer, i32 start, i32 end, u64 cost).
+     */
+    void write(BinaryWriter& out) const {
+        out.putU32(static_cast<std::uint32_t>(vehicles.size()));
+        for (const auto& e : vehicles) {
+            out.putString(e.regNumber);
+            out.putString(e.brand);
+            out.putString(e.model);
+            out.putU8(e.kind);
+            out.putString(e.label);
+        }
+        out.putU32(static_cast<std::uint32_t>(customers.size()));
+        for (const auto& e : customers) {
+            out.putString(e.id);
+            out.putString(e.name);
+            out.putU8(e.type);
+            out.putString(e.label);
+        }
+        out.putU32(static_cast<std::uint32_t>(records.size()));
+        for (const auto& r : records) {
+            out.putU32(r.vehicle);
+            out.putU32(r.customer);
+            out.putI32(r.startDay);
+            out.putI32(r.endDay);
+            out.putU64(static_cast<std::uint64_t>(r.costGrosze));
+        }
+    }
+
+    /**
+     * @brief Replace the contents with data encoded by write().
+     * @throws std::runtime_error If the data is truncated or refers to missing entries.
+     */
+    void read(BinaryReader& in) {
+        clear();
+        std::uint32_t vCount = in.getU32();
+        for (std::uint32_t i = 0; i < vCount; ++i) {
+            VehicleEntry e;
+            e.regNumber = in.getString();
+            e.brand = in.getString();
+            e.model = in.getString();
+            e.kind = in.getU8();
+            e.label = in.getString();
+            addVehicle(std::move(e));
+        }
+        std::uint32_t cCount = in.getU32();
+        for (std::uint32_t i = 0; i < cCount; ++i) {
+            CustomerEntry e;
+            e.id = in.getString();
+            e.name = in.getString();
+            e.type = in.getU8();
+            e.label = in.getString();
+            addCustomer(std::move(e));
+        }
+        std::uint32_t rCount = in.getU32();
+        records.reserve(std::min<std::size_t>(rCount, in.remaining() / 24));
+        for (std::uint32_t i = 0; i < rCount; ++i) {
+            HistoryRecord r;
+            r.vehicle = in.getU32();
+            r.customer = in.getU32();
+            r.startDay = in.getI32();
+            r.endDay = in.getI32();
+            r.costGrosze = static_cast<std::int64_t>(in.getU64());
+            if (r.vehicle >= vehicles.size() || r.customer >= customers.size()) {
+                throw std::runtime_error("Corrupt rental history.");
+            }
+            records.push_back(r);
+        }
+    }
+
+    const std::vector<HistoryRecord>& getRecords() const { return records; }
+    const std::vector<VehicleEntry>& getVehicles() const { return vehicles; }
+    const std::vector<CustomerEntry>& getCustomers() const { return customers; }
+    const VehicleEntry& vehicleOf(const HistoryRecord& r) const { return vehicles[r.vehicle]; }
+    const CustomerEntry& customerOf(const HistoryRecord& r) const { return customers[r.customer]; }
+
+    std::size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+    void reserve(std::size_t n) { records.reserve(n); }
+
+    void clear() {
+        records.clear();
+        vehicles.clear();
+        customers.clear();
+        vehicleByReg.clear();
+        customerById.clear();
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "RentalHistory.hpp"
+#include "Vehicle.hpp"
+#include "Date.hpp"
+#include "HashIndex.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class RentalStats
+ * @brief Revenue and utilization rollups over completed rentals.
+ *
+ * Every completed rental is added once. The rollups are kept per vehicle
+ * (registration number), brand, vehicle type, customer (ID) and month, so
+ * a group-by query only walks its groups. Revenue and rental counts go to
+ * the month in which the rental ended; rented days are split over the
+ * months they fall in. A rental counts as Rental::getRentalDays() days
+ * starting on its start date.
+ *
+ * Rollups of disjoint parts of the history can be built independently and
+ * merged, which is how they are rebuilt in parallel.
+ */
+class RentalStats {
+public:
+    static constexpr int unknownKind = Vehicle::kindCount; ///< byKind() index of vehicles of unknown type
+
+    /**
+     * @brief Aggregated figures of one group.
+     */
+    struct Totals {
+        std::int64_t revenueGrosze = 0; ///< Revenue in grosze (1/100 zl)
+        std::uint64_t rentals = 0;      ///< Number of completed rentals
+        std::int64_t rentedDays = 0;    ///< Rented vehicle-days
+
+        double getRevenue() const { return static_cast<double>(revenueGrosze) / 100.0; }
+
+        void add(const Totals& other) {
+            revenueGrosze += other.revenueGrosze;
+            rentals += other.rentals;
+            rentedDays += other.rentedDays;
+        }
+    };
+
+    /**
+     * @brief Result row of a group-by query.
+     */
+    struct Group {
+        std::string key;
+        Totals totals;
+    };
+
+private:
+    /**
+     * @brief Totals keyed by string, in order of first appearance.
+     */
+    struct Rollup {
+        std::vector<Group> groups;
+        HashIndex<std::size_t> positions; ///< Key -> index in groups
+
+        void add(std::string_view key, const Totals& delta) {
+            auto* pos = positions.find(key);
+            if (pos) {
+                groups[*pos].totals.add(delta);
+                return;
+            }
+            positions.insert(key, groups.size());
+            groups.push_back(Group{std::string(key), delta});
+        }
+
+        void merge(const Rollup& other) {
+            for (const auto& g : other.groups) add(g.key, g.totals);
+        }
+
+        void clear() {
+            groups.clear();
+            positions.clear();
+        }
+    };
+
+    Totals overall;
+    Rollup vehicles;
+    Rollup brands;
+    Rollup customers;
+    std::array<Totals, Vehicle::kindCount + 1> kinds{};
+    std::map<int, Totals> months; ///< year * 12 + month - 1 -> totals
+
+    static int monthKey(int year, int month) { return year * 12 + month - 1; }
+
+public:
+    /**
+     * @brief Add a completed rental.
+     * @param part History holding the record (resolves its vehicle and customer).
+     */
+    void add(const RentalHistory& part, const HistoryRecord& r) {
+        const auto& vehicle = part.vehicleOf(r);
+        Totals delta;
+        delta.revenueGrosze = r.costGrosze;
+        delta.rentals = 1;
+        delta.rentedDays = std::max<std::int64_t>(1, r.endDay - r.startDay);
+
+        overall.add(delta);
+        vehicles.add(vehicle.regNumber, delta);
+        brands.add(vehicle.brand, delta);
+        customers.add(part.customerOf(r).id, delta);
+        kinds[vehicle.kind < Vehicle::kindCount ? vehicle.kind : unknownKind].add(delta);
+
+        int year = 0, month = 0, day = 0;
+        Date::toCivil(r.endDay, year, month, day);
+        Totals& ended = months[monthKey(year, month)];
+        ended.revenueGrosze += delta.revenueGrosze;
+        ended.rentals += 1;
+
+        // Rented days of each month the rental spans
+        int from = r.startDay;
+        const int to = r.startDay + static_cast<int>(delta.rentedDays);
+        while (from < to) {
+            Date::toCivil(from, year, month, day);
+            int monthEnd = from - day + 1 + Date::daysInMonth(month, year);
+            int until = std::min(to, monthEnd);
+            months[monthKey(year, month)].rentedDays += until - from;
+            from = until;
+        }
+    }
+
+    /**
+     * @brief Add the rollups of another part of the history.
+     */
+    void merge(const RentalStats& other) {
+        overall.add(other.overall);
+        vehicles.merge(other.vehicles);
+        brands.merge(other.brands);
+        customers.merge(other.customers);
+        for (std::size_t k = 0; k < kinds.size(); ++k) kinds[k].add(other.kinds[k]);
+        for (const auto& [key, totals] : other.months) months[key].add(totals);
+    }
+
+    void clear() {
+        overall = Totals{};
+        vehicles.clear();
+        brands.clear();
+        customers.clear();
+        kinds.fill(Totals{});
+        months.clear();
+    }
+
+    /**
+     * @brief Totals over the whole history.
+     */
+    const Totals& total() const { return overall; }
+
+    /**
+     * @brief Revenue per vehicle, keyed by registration number.
+     */
+    const std::vector<Group>& byVehicle() const { return vehicles.groups; }
+
+    /**
+     * @brief Revenue per brand.
+     */
+    const std::vector<Group>& byBrand() const { return brands.groups; }
+
+    /**
+     * @brief Revenue per customer, keyed by customer ID.
+     */
+    const std::vector<Group>& byCustomer() const { return customers.groups; }
+
+    /**
+     * @brief Revenue per vehicle type, indexed by VehicleKind (unknownKind for history of unknown type).
+     */
+    const std::array<Totals, Vehicle::kindCount + 1>& byKind() const { return kinds; }
+
+    /**
+     * @brief Revenue per month ("YYYY-MM"), oldest first.
+     */
+    std::vector<Group> byMonth() const {
+        std::vector<Group> out;
+        out.reserve(months.size());
+        for (const auto& [key, totals] : months) {
+            char buf[32];
+            std::snprintf(buf, sizeof buf, "%04d-%02d", key / 12, key % 12 + 1);
+            out.push_back(Group{buf, totals});
+        }
+        return out;
+    }
+
+    /**
+     * @brief Totals of one month (all zero if nothing was rented).
+     */
+    Totals forMonth(int year, int month) const {
+        auto it = months.find(monthKey(year, month));
+        return it == months.end() ? Totals{} : it->second;
+    }
+
+    /**
+     * @brief Rented days divided by available days (0 if no days were available).
+     */
+    static double utilization(const Totals& t, std::int64_t availableDays) {
+        return availableDays > 0 ? static_cast<double>(t.rentedDays) / static_cast<double>(availableDays) : 0.0;
+    }
+
+    /**
+     * @brief Utilization of a fleet of the given size in one month.
+     */
+    double utilization(int year, int month, std::size_t fleetSize) const {
+        return utilization(forMonth(year, month),
+                           static_cast<std::int64_t>(fleetSize) * Date::daysInMonth(month, year));
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,414 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "Customer.hpp"
+#include "CombustionCar.hpp"
+#include "ElectricCar.hpp"
+#include "Truck.hpp"
+#include "Motorcycle.hpp"
+#include "FleetColumns.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace bk {
+
+/**
+ * @class BinaryWriter
+ * @brief Appends little-endian values and length-prefixed strings to a byte buffer.
+ */
+class BinaryWriter {
+private:
+    std::string buffer;   ///< Encoded bytes
+    std::size_t recordStart = 0; ///< Offset of the open record's length field
+
+public:
+    void putU8(std::uint8_t v) { buffer.push_back(static_cast<char>(v)); }
+
+    void putU32(std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) buffer.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    void putI32(std::int32_t v) { putU32(static_cast<std::uint32_t>(v)); }
+
+    void putU64(std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) buffer.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+
+    void putDouble(double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        putU64(bits);
+    }
+
+    void putString(std::string_view s) {
+        putU32(static_cast<std::uint32_t>(s.size()));
+        buffer.append(s.data(), s.size());
+    }
+
+    void putBytes(const char* data, std::size_t n) { buffer.append(data, n); }
+
+    /**
+     * @brief Append an already encoded record body with its length prefix.
+     */
+    void putRecord(std::string_view body) { putString(body); }
+
+    /**
+     * @brief Start a length-prefixed record (records do not nest).
+     */
+    void beginRecord() {
+        recordStart = buffer.size();
+        putU32(0);
+    }
+
+    /**
+     * @brief Close the open record by filling in its length.
+     */
+    void endRecord() {
+        auto len = static_cast<std::uint32_t>(buffer.size() - recordStart - 4);
+        for (int i = 0; i < 4; ++i) buffer[recordStart + i] = static_cast<char>((len >> (8 * i)) & 0xFF);
+    }
+
+    const std::string& data() const { return buffer; }
+    void clear() { buffer.clear(); }
+};
+
+/**
+ * @class BinaryReader
+ * @brief Reads values written by BinaryWriter from a byte range it does not own.
+ * @throws std::runtime_error On reads past the end of the range.
+ */
+class BinaryReader {
+private:
+    const char* cur; ///< Next byte to read
+    const char* end; ///< One past the last byte
+
+    void need(std::size_t n) const {
+        if (static_cast<std::size_t>(end - cur) < n) throw std::runtime_error("Snapshot is truncated.");
+    }
+
+public:
+    BinaryReader(const char* data, std::size_t size) : cur(data), end(data + size) {}
+
+    std::uint8_t getU8() {
+        need(1);
+        return static_cast<std::uint8_t>(*cur++);
+    }
+
+    std::uint32_t getU32() {
+        need(4);
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<std::uint32_t>(static_cast<unsigned char>(cur[i])) << (8 * i);
+        cur += 4;
+        return v;
+    }
+
+    std::int32_t getI32() { return static_cast<std::int32_t>(getU32()); }
+
+    std::uint64_t getU64() {
+        need(8);
+        std::uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<std::uint64_t>(static_cast<unsigned char>(cur[i])) << (8 * i);
+        cur += 8;
+        return v;
+    }
+
+    double getDouble() {
+        std::uint64_t bits = getU64();
+        double v;
+        std::memcpy(&v, &bits, sizeof v);
+        return v;
+    }
+
+    /**
+     * @brief Read a length-prefixed string without copying it.
+     * @return View into the underlying bytes.
+     */
+    std::string_view getString() {
+        std::uint32_t len = getU32();
+        need(len);
+        std::string_view s(cur, len);
+        cur += len;
+        return s;
+    }
+
+    /**
+     * @brief Read a length-prefixed record and advance past it.
+     * @return Reader limited to the record body.
+     */
+    BinaryReader getRecord() {
+        std::string_view body = getString();
+        return BinaryReader(body.data(), body.size());
+    }
+
+    /**
+     * @brief Read a length-prefixed record and advance past it.
+     * @return View of the record body.
+     */
+    std::string_view getRecordBytes() { return getString(); }
+
+    /**
+     * @brief Advance past n bytes.
+     */
+    void skip(std::size_t n) {
+        need(n);
+        cur += n;
+    }
+
+    const char* position() const { return cur; }
+    std::size_t remaining() const { return static_cast<std::size_t>(end - cur); }
+};
+
+/**
+ * @class Snapshot
+ * @brief Binary snapshot format of VehicleManager state.
+ *
+ * Layout (all integers little-endian, strings as u32 length + bytes):
+ *   magic "BKVS", u32 version,
+ *   u32 vehicle count,  records,
+ *   u32 customer count, records,
+ *   u32 rental count,   records (reg, customer ID, start, end),
+ *   u32 history count,  strings,
+ *   u32 reservation count, records (reg, customer ID, start, end) - since version 2,
+ *   u32 interval count, doubles (km between services per task) - since version 3,
+ *   u32 service count, records (reg, task name, mileage at last service) - since version 3
+ *   (optional in version 2).
+ * Every record is prefixed with its u32 byte length, so readers can skip
+ * records and fields added by later versions.
+ */
+class Snapshot {
+public:
+    static constexpr char magic[4] = {'B', 'K', 'V', 'S'};
+    static constexpr std::uint32_t version = 3;
+
+    /**
+     * @brief Write the snapshot header.
+     */
+    static void writeHeader(BinaryWriter& out) {
+        out.putBytes(magic, sizeof magic);
+        out.putU32(version);
+    }
+
+    /**
+     * @brief Check the snapshot header.
+     * @return Version of the file (1 up to version).
+     * @throws std::runtime_error If the magic does not match or the version is unknown.
+     */
+    static std::uint32_t readHeader(BinaryReader& in) {
+        for (char c : magic) {
+            if (static_cast<char>(in.getU8()) != c) throw std::runtime_error("Not a vehicle snapshot file.");
+        }
+        std::uint32_t fileVersion = in.getU32();
+        if (fileVersion < 1 || fileVersion > version) throw std::runtime_error("Unsupported snapshot version.");
+        return fileVersion;
+    }
+
+    /**
+     * @brief Write a vehicle record.
+     */
+    static void writeVehicle(BinaryWriter& out, const Vehicle& v) {
+        out.beginRecord();
+        out.putU8(static_cast<std::uint8_t>(v.getKind()));
+        out.putString(v.getRegNumber());
+        out.putString(v.getBrand());
+        out.putString(v.getModel());
+        out.putDouble(v.getMileage());
+        out.putDouble(v.getBaseCost());
+        out.putU8(static_cast<std::uint8_t>(v.getLicenceCategory()));
+        switch (v.getKind()) {
+            case Vehicle::VehicleKind::CombustionCar: {
+                const auto& p = static_cast<const CombustionCar&>(v);
+                putCombustion(out, p);
+                out.putI32(p.getDoors());
+                break;
+            }
+            case Vehicle::VehicleKind::ElectricCar: {
+                const auto& p = static_cast<const ElectricCar&>(v);
+                out.putDouble(p.getBatteryCapacity());
+                out.putI32(p.getDoors());
+                break;
+            }
+            case Vehicle::VehicleKind::Truck: {
+                const auto& p = static_cast<const Truck&>(v);
+                putCombustion(out, p);
+                out.putI32(p.getCargoCapacity());
+                break;
+            }
+            case Vehicle::VehicleKind::Motorcycle:
+                putCombustion(out, static_cast<const CombustionVehicle&>(v));
+                break;
+        }
+        out.endRecord();
+    }
+
+    /**
+     * @brief Build a vehicle from a record body.
+     * @return New vehicle (caller takes ownership).
+     * @throws std::invalid_argument If the stored values fail validation.
+     * @throws std::runtime_error If the record is malformed.
+     */
+    static Vehicle* readVehicle(BinaryReader in) {
+        auto kind = static_cast<Vehicle::VehicleKind>(in.getU8());
+        std::string reg(in.getString());
+        std::string brand(in.getString());
+        std::string model(in.getString());
+        double miles = in.getDouble();
+        double cost = in.getDouble();
+        auto cat = static_cast<Vehicle::LicenceCategory>(in.getU8());
+        switch (kind) {
+            case Vehicle::VehicleKind::CombustionCar: {
+                int engine = in.getI32();
+                double consumption = in.getDouble();
+                auto fuel = static_cast<CombustionVehicle::FuelType>(in.getU8());
+                int doors = in.getI32();
+                return new CombustionCar(reg, brand, model, miles, cost, cat, engine, consumption, fuel, doors);
+            }
+            case Vehicle::VehicleKind::ElectricCar: {
+                double battery = in.getDouble();
+                int doors = in.getI32();
+                return new ElectricCar(reg, brand, model, miles, cost, cat, battery, doors);
+            }
+            case Vehicle::VehicleKind::Truck: {
+                int engine = in.getI32();
+                double consumption = in.getDouble();
+                auto fuel = static_cast<CombustionVehicle::FuelType>(in.getU8());
+                int capacity = in.getI32();
+                return new Truck(reg, brand, model, miles, cost, cat, engine, consumption, fuel, capacity);
+            }
+            case Vehicle::VehicleKind::Motorcycle: {
+                int engine = in.getI32();
+                double consumption = in.getDouble();
+                auto fuel = static_cast<CombustionVehicle::FuelType>(in.getU8());
+                return new Motorcycle(reg, brand, model, miles, cost, cat, engine, consumption, fuel);
+            }
+        }
+        throw std::runtime_error("Unknown vehicle kind in snapshot.");
+    }
+
+    /**
+     * @brief Fields of a vehicle record needed to index it without building the object.
+     * Views point into the record bytes.
+     */
+    struct VehicleSummary {
+        std::string_view regNumber;
+        std::string_view brand;
+        std::string_view model;
+        FleetColumns::Row row;
+    };
+
+    /**
+     * @brief Decode the indexed fields of a vehicle record and check every field
+     *        the way the constructors do, without building the object.
+     * A record that passes is built by readVehicle() without error.
+     * @throws std::invalid_argument If the stored values fail validation.
+     * @throws std::runtime_error If the record is malformed.
+     */
+    static VehicleSummary readVehicleSummary(BinaryReader in) {
+        VehicleSummary s;
+        std::uint8_t kind = in.getU8();
+        s.regNumber = in.getString();
+        s.brand = in.getString();
+        s.model = in.getString();
+        s.row.mileage = in.getDouble();
+        s.row.baseCost = in.getDouble();
+        s.row.licence = in.getU8();
+        s.row.kind = kind;
+        if (kind >= Vehicle::kindCount) throw std::runtime_error("Unknown vehicle kind in snapshot.");
+        Vehicle::validate(s.regNumber, s.brand, s.model, s.row.mileage, s.row.baseCost);
+        if (s.row.licence > static_cast<std::uint8_t>(Vehicle::LicenceCategory::C)) {
+            throw std::invalid_argument("Invalid licence category.");
+        }
+        if (static_cast<Vehicle::VehicleKind>(kind) == Vehicle::VehicleKind::ElectricCar) {
+            s.row.batteryCapacity = in.getDouble();
+            if (!(s.row.batteryCapacity > 0.0)) throw std::invalid_argument("Battery capacity must be positive.");
+            if (in.getI32() <= 0) throw std::invalid_argument("Number of doors must be positive.");
+            return s;
+        }
+        s.row.engineSize = in.getI32();
+        s.row.fuelConsumption = in.getDouble();
+        s.row.fuelType = in.getU8();
+        if (s.row.engineSize <= 0) throw std::invalid_argument("Engine size must be positive.");
+        if (!(s.row.fuelConsumption > 0.0)) throw std::invalid_argument("Fuel consumption must be positive.");
+        if (s.row.fuelType > static_cast<std::uint8_t>(CombustionVehicle::FuelType::Diesel)) {
+            throw std::invalid_argument("Invalid fuel type.");
+        }
+        switch (static_cast<Vehicle::VehicleKind>(kind)) {
+            case Vehicle::VehicleKind::CombustionCar:
+                if (in.getI32() <= 0) throw std::invalid_argument("Number of doors must be positive.");
+                break;
+            case Vehicle::VehicleKind::Truck:
+                s.row.cargoCapacity = in.getI32();
+                if (s.row.cargoCapacity <= 0) throw std::invalid_argument("Cargo capacity must be positive.");
+                break;
+            default:
+                break;
+        }
+        return s;
+    }
+
+    /**
+     * @brief Write a customer record.
+     */
+    static void writeCustomer(BinaryWriter& out, const Customer& c) {
+        out.beginRecord();
+        out.putU8(static_cast<std::uint8_t>(c.getType()));
+        out.putString(c.getName());
+        out.putString(c.getAddress());
+        out.putString(c.getId());
+        out.endRecord();
+    }
+
+    /**
+     * @brief Build a customer from a record body.
+     * @return New customer (caller takes ownership).
+     */
+    static Customer* readCustomer(BinaryReader in) {
+        auto type = static_cast<CustomerType>(in.getU8());
+        std::string name(in.getString());
+        std::string address(in.getString());
+        std::string id(in.getString());
+        if (type == CustomerType::Private) return new PrivateCustomer(name, address, id);
+        if (type == CustomerType::Business) return new BusinessCustomer(name, address, id);
+        throw std::runtime_error("Unknown customer type in snapshot.");
+    }
+
+    /**
+     * @brief Fields of a customer record needed to index it without building the object.
+     */
+    struct CustomerSummary {
+        CustomerType type = CustomerType::Private;
+        std::string_view name;
+        std::string_view id;
+    };
+
+    /**
+     * @brief Decode the indexed fields of a customer record and check them the way
+     *        the constructors do, without building the object.
+     * @throws std::invalid_argument If the stored values fail validation.
+     * @throws std::runtime_error If the record is malformed.
+     */
+    static CustomerSummary readCustomerSummary(BinaryReader in) {
+        auto type = static_cast<CustomerType>(in.getU8());
+        if (type != CustomerType::Private && type != CustomerType::Business) {
+            throw std::runtime_error("Unknown customer type in snapshot.");
+        }
+        std::string_view name = in.getString();
+        std::string_view address = in.getString();
+        std::string_view id = in.getString();
+        Customer::validate(id, name, address);
+        return {type, name, id};
+    }
+
+private:
+    static void putCombustion(BinaryWriter& out, const CombustionVehicle& v) {
+        out.putI32(v.getEngineSize());
+        out.putDouble(v.getFuelConsumption());
+        out.putU8(static_cast<std::uint8_t>(v.getFuelType()));
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// Floating-point std::from_chars needs libstdc++ 11 or newer (older MinGW
+// toolchains lack it). CMake probes for it; without CMake the library's
+// feature macro decides.
+#ifndef BK_HAVE_FLOAT_FROM_CHARS
+#if defined(__cpp_lib_to_chars)
+#define BK_HAVE_FLOAT_FROM_CHARS 1
+#else
+#define BK_HAVE_FLOAT_FROM_CHARS 0
+#endif
+#endif
+
+namespace bk {
+
+/**
+ * @class TextReader
+ * @brief Splits a text buffer it does not own into lines and fields without copying.
+ *
+ * Lines and fields are views into the buffer, numbers are parsed with
+ * std::from_chars, so reading a record does not allocate (except for
+ * floating-point numbers on libraries without floating-point from_chars,
+ * which fall back to std::strtod on a copy of the field).
+ */
+class TextReader {
+private:
+    const char* cur; ///< Start of the next line
+    const char* end; ///< One past the last byte
+
+    /**
+     * @brief Drop leading whitespace and a leading '+' (accepted by stoi/stod).
+     * A '+' followed by whitespace is kept, so the number is rejected like by stoi/stod.
+     */
+    static std::string_view trimNumber(std::string_view s) {
+        std::size_t i = 0;
+        while (i < s.size() && (s[i] == ' ' || s[i] == '\t')) ++i;
+        if (i + 1 < s.size() && s[i] == '+' && s[i + 1] != ' ' && s[i + 1] != '\t') ++i;
+        return s.substr(i);
+    }
+
+public:
+    TextReader(const char* data, std::size_t size) : cur(data), end(data + size) {}
+
+    /**
+     * @brief Read the next line (without "\n" or "\r\n").
+     * @return false at the end of the buffer.
+     */
+    bool nextLine(std::string_view& line) {
+        if (cur == end) return false;
+        const char* nl = static_cast<const char*>(std::memchr(cur, '\n', static_cast<std::size_t>(end - cur)));
+        const char* lineEnd = nl ? nl : end;
+        line = std::string_view(cur, static_cast<std::size_t>(lineEnd - cur));
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        cur = nl ? nl + 1 : end;
+        return true;
+    }
+
+    /**
+     * @brief Split a line on a separator like repeated std::getline calls would
+     * (no field for an empty line or after a trailing separator).
+     * @param fields Receives the first N fields.
+     * @return Total number of fields (may exceed N).
+     */
+    template <std::size_t N>
+    static std::size_t split(std::string_view line, std::array<std::string_view, N>& fields, char sep = ';') {
+        std::size_t count = 0;
+        std::size_t start = 0;
+        while (start < line.size()) {
+            std::size_t pos = line.find(sep, start);
+            if (pos == std::string_view::npos) pos = line.size();
+            if (count < N) fields[count] = line.substr(start, pos - start);
+            ++count;
+            start = pos + 1;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Parse the leading integer of a field (trailing characters are ignored, like std::stoi).
+     * @throws std::invalid_argument If the field does not start with a number.
+     */
+    static int toInt(std::string_view s) {
+        s = trimNumber(s);
+        int value = 0;
+        auto res = std::from_chars(s.data(), s.data() + s.size(), value);
+        if (res.ec != std::errc()) throw std::invalid_argument("Invalid integer: " + std::string(s));
+        return value;
+    }
+
+    /**
+     * @brief Parse the leading floating-point number of a field (trailing characters are ignored, like std::stod).
+     * @throws std::invalid_argument If the field does not start with a number, or the number
+     *         is NaN or infinite.
+     */
+    static double toDouble(std::string_view s) {
+        s = trimNumber(s);
+#if BK_HAVE_FLOAT_FROM_CHARS
+        double value = 0.0;
+        auto res = std::from_chars(s.data(), s.data() + s.size(), value);
+        if (res.ec != std::errc() || !std::isfinite(value)) {
+            throw std::invalid_argument("Invalid number: " + std::string(s));
+        }
+        return value;
+#else
+        // strtod also reads hex, which from_chars does not
+        std::string copy(s);
+        std::size_t digits = copy[0] == '-' ? 1 : 0;
+        if (copy.size() > digits + 1 && copy[digits] == '0' && (copy[digits + 1] == 'x' || copy[digits + 1] == 'X')) {
+            copy.resize(digits + 1); // from_chars stops at the 'x'
+        }
+        char* parsedEnd = nullptr;
+        errno = 0;
+        double value = std::strtod(copy.c_str(), &parsedEnd);
+        if (parsedEnd == copy.c_str() || errno == ERANGE || !std::isfinite(value)) {
+            throw std::invalid_argument("Invalid number: " + copy);
+        }
+        return value;
+#endif
+    }
+};
+
+} // namespace bk
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace bk {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads running queued tasks in FIFO order.
+ *
+ * The destructor finishes all queued tasks before joining the workers.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks; ///< Tasks not started yet
+    std::mutex mutex;                        ///< Guards tasks and stopping
+    std::condition_variable wake;            ///< Signalled on new tasks and on stop
+    bool stopping = false;
+
+    void run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return; // stopping and drained
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    /**
+     * @brief Start the workers.
+     * @param threads Number of workers (0 = one per hardware thread).
+     */
+    explicit ThreadPool(std::size_t threads = 0) {
+        if (threads == 0) threads = defaultThreadCount();
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) workers.emplace_back([this] { run(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    /**
+     * @brief Number of hardware threads (at least 1).
+     */
+    static std::size_t defaultThreadCount() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    std::size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Queue a task.
+     * @return Future holding the task's result or exception.
+     */
+    template <typename F>
+    auto submit(F&& f) -> std::future<std::invoke_result_t<F>> {
+        using R = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+        std::future<R> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+};
+
+} // namespace bk
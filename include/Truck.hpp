@@ -89,6 +89,14 @@ public:
         return MainVehicleType::Truck;
     }
 
+    /**
+     * @brief Get the concrete vehicle kind.
+     * @return VehicleKind enum value.
+     */
+    VehicleKind getKind() const override {
+        return VehicleKind::Truck;
+    }
+
     // Setters
     /**
      * @brief Set the cargo capacity.
@@ -100,6 +108,7 @@ public:
             throw std::invalid_argument("Cargo capacity must be positive.");
         }
         cargoCapacity = capacity;
+        notifyChanged();
     }
 
     // Getters
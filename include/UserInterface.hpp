@@ -201,6 +201,9 @@ private:
         std::cout << "10. Show Rental History\n";
         std::cout << "11. Search\n";
         std::cout << "12. Save Data\n";
+        std::cout << "13. Reservations\n";
+        std::cout << "14. Overdue Rentals\n";
+        std::cout << "15. Maintenance\n";
         std::cout << "0. Exit\n";
         std::cout << "Select option: ";
     }
@@ -377,6 +380,115 @@ private:
         }
     }
 
+    /**
+     * @brief UI handling for reservations.
+     */
+    void reservationsUI() {
+        std::cout << "\n=== RESERVATIONS ===\n";
+        std::cout << "1. Reserve Vehicle\n";
+        std::cout << "2. Cancel Reservation\n";
+        std::cout << "3. Show Vehicle Reservations\n";
+        std::cout << "4. Vehicles Free for a Period\n";
+        int choice = getValidInt("Select option: ");
+
+        if (choice == 1) {
+            std::string reg, id, start, end;
+            reg = getValidString("Vehicle Reg: ");
+            id = getValidString("Customer ID: ");
+            start = getValidDate("Start (YYYY-MM-DD): ");
+            end = getValidDate("End (YYYY-MM-DD): ");
+            vm.reserveVehicle(reg, id, start, end);
+            std::cout << "Vehicle reserved successfully.\n";
+        } else if (choice == 2) {
+            std::string reg, start;
+            reg = getValidString("Vehicle Reg: ");
+            start = getValidDate("Start (YYYY-MM-DD): ");
+            vm.cancelReservation(reg, start);
+            std::cout << "Reservation cancelled.\n";
+        } else if (choice == 3) {
+            std::string reg;
+            reg = getValidString("Vehicle Reg: ");
+            auto results = vm.getReservations(reg);
+            if (results.empty()) {
+                std::cout << "No reservations for this vehicle.\n";
+            } else {
+                for (const auto& b : results) {
+                    std::cout << Date::toString(b.startDay) << " - " << Date::toString(b.endDay)
+                              << "  Customer: " << b.customerId << "\n";
+                }
+            }
+        } else if (choice == 4) {
+            std::string start, end;
+            start = getValidDate("Start (YYYY-MM-DD): ");
+            end = getValidDate("End (YYYY-MM-DD): ");
+            auto results = vm.findVehiclesFreeDuring(start, end);
+            if (results.empty()) {
+                std::cout << "No vehicles are free for the whole period.\n";
+            } else {
+                std::cout << "\n";
+                for (auto* v : results) {
+                    std::cout << *v << "\n-----------------\n";
+                }
+            }
+        } else {
+            std::cout << "Invalid option.\n";
+        }
+    }
+
+    /**
+     * @brief UI listing overdue rentals and rentals due soon.
+     */
+    void overdueUI() {
+        std::string date = getValidDate("As of (YYYY-MM-DD): ");
+        int days = getValidInt("Also show rentals due within days: ", 0);
+        auto overdue = vm.findOverdueRentals(date);
+        auto dueSoon = vm.findRentalsDueWithin(date, days);
+        std::cout << "\n=== OVERDUE (" << overdue.size() << ") ===\n";
+        for (const auto* r : overdue) {
+            std::cout << r->getEndDate() << "  " << r->getVehicle()->getRegNumber()
+                      << "  Customer: " << r->getCustomer()->getId() << "\n";
+        }
+        std::cout << "=== DUE SOON (" << dueSoon.size() << ") ===\n";
+        for (const auto* r : dueSoon) {
+            std::cout << r->getEndDate() << "  " << r->getVehicle()->getRegNumber()
+                      << "  Customer: " << r->getCustomer()->getId() << "\n";
+        }
+    }
+
+    /**
+     * @brief UI handling for vehicle maintenance.
+     */
+    void maintenanceUI() {
+        std::cout << "\n=== MAINTENANCE ===\n";
+        std::cout << "1. Vehicles Due for Service\n";
+        std::cout << "2. Record Service\n";
+        int choice = getValidInt("Select option: ");
+
+        if (choice == 1) {
+            double km = getValidDouble("Also show vehicles due within km: ", 0);
+            auto results = vm.findVehiclesDueForService(km);
+            if (results.empty()) {
+                std::cout << "No vehicles are due for service.\n";
+            } else {
+                for (auto* v : results) {
+                    std::cout << v->getRegNumber() << "  " << v->getBrand() << " " << v->getModel()
+                              << "  km to service: " << vm.getKmToService(v->getRegNumber()) << "\n";
+                }
+            }
+        } else if (choice == 2) {
+            std::string reg = getValidString("Vehicle Reg: ");
+            int task = getValidInt("Service:    1.Oil Change    2.Battery Check    3.Inspection: ", 1);
+            if (task > MaintenanceSchedule::taskCount) {
+                std::cout << "Invalid option.\n";
+                return;
+            }
+            vm.serviceVehicle(reg, static_cast<MaintenanceSchedule::Task>(task - 1));
+            std::cout << "Service recorded.\n";
+        } else {
+            std::cout << "Invalid option.\n";
+        }
+    }
+
 public:
     /**
      * @brief Constructor.
@@ -485,11 +597,21 @@ public:
                     case 9: std::cout << "\n"; vm.showInfo(); break;
                     case 10: vm.showRentalHistory(); break;
                     case 11: searchUI(); break;
-                    case 12: vm.saveToFile("data.txt"); std::cout << "Saved.\n"; break;
+                    case 12:
+                        vm.checkpointAsync();
+                        std::cout << "Saving in the background (data.txt is only read on the first run).\n";
+                        break;
+                    case 13: reservationsUI(); break;
+                    case 14: overdueUI(); break;
+                    case 15: maintenanceUI(); break;
                     case 0: {
                         if (getValidYesNo("Do you want to save data before exiting? (y/n): ")) {
-                            vm.saveToFile("data.txt");
+                            vm.checkpointAsync();
+                            vm.waitForCheckpoint();
                             std::cout << "Data saved.\n";
+                        } else {
+                            vm.discardJournal();
+                            std::cout << "Changes discarded.\n";
                         }
                         std::cout << "Exiting...\n"; 
                         break;
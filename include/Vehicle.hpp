@@ -1,10 +1,29 @@
 #pragma once
 
+#include <cmath>
 #include <string>
+#include <string_view>
 #include <stdexcept>
 
 namespace bk {
 
+class Vehicle;
+
+/**
+ * @class VehicleObserver
+ * @brief Interface notified when a vehicle's attributes change through its setters.
+ */
+class VehicleObserver {
+public:
+    virtual ~VehicleObserver() = default;
+
+    /**
+     * @brief Called after a setter changed the vehicle.
+     * @param v The changed vehicle.
+     */
+    virtual void onVehicleChanged(const Vehicle& v) = 0;
+};
+
 class Vehicle {
 public:
     /**
@@ -27,6 +46,19 @@ public:
         C
     };
 
+    /**
+     * @enum VehicleKind
+     * @brief Concrete class of the vehicle, used instead of dynamic_cast for type filtering.
+     */
+    enum class VehicleKind {
+        CombustionCar,
+        ElectricCar,
+        Truck,
+        Motorcycle
+    };
+
+    static constexpr int kindCount = 4; ///< Number of VehicleKind values
+
 protected:
     std::string regNumber;      /// Registration number (Unique ID)
     std::string brand;          /// Vehicle Brand
@@ -34,6 +66,14 @@ protected:
     double mileage;             /// Current mileage in km
     double baseCost;            /// Base daily rental cost in zl
     LicenceCategory licenceCat; /// Required licence category
+    VehicleObserver* observer = nullptr; /// Notified on changes (not owned)
+
+    /**
+     * @brief Notify the observer (if any) that the vehicle changed.
+     */
+    void notifyChanged() {
+        if (observer) observer->onVehicleChanged(*this);
+    }
 
 public:
     /**
@@ -57,10 +97,23 @@ public:
             double miles, double cost, LicenceCategory cat)
         : regNumber(reg), brand(brandVal), model(modelVal), mileage(miles), baseCost(cost), licenceCat(cat) 
     {
-        if (regNumber.empty()) throw std::invalid_argument("Registration number cannot be empty.");
-        if (regNumber.length() > 9) throw std::invalid_argument("Registration number cannot exceed 9 characters.");
-        if (brand.empty()) throw std::invalid_argument("Brand cannot be empty.");
-        if (model.empty()) throw std::invalid_argument("Model cannot be empty.");
+        validate(regNumber, brand, model, mileage, baseCost);
+    }
+
+    /**
+     * @brief Check the fields validated by the constructor (also used on snapshot records).
+     * Mileage and cost key the price index and the maintenance schedule, so NaN and
+     * infinity are rejected.
+     * @throws std::invalid_argument If validation fails.
+     */
+    static void validate(std::string_view reg, std::string_view brandVal, std::string_view modelVal,
+                         double miles, double cost) {
+        if (reg.empty()) throw std::invalid_argument("Registration number cannot be empty.");
+        if (reg.length() > 9) throw std::invalid_argument("Registration number cannot exceed 9 characters.");
+        if (brandVal.empty()) throw std::invalid_argument("Brand cannot be empty.");
+        if (modelVal.empty()) throw std::invalid_argument("Model cannot be empty.");
+        if (!std::isfinite(miles)) throw std::invalid_argument("Mileage must be a finite number.");
+        if (!std::isfinite(cost)) throw std::invalid_argument("Base cost must be a finite number.");
     }
 
     /**
@@ -87,24 +140,30 @@ public:
      */
     virtual MainVehicleType getMainVehicleType() const = 0;
 
+    /**
+     * @brief Get the concrete kind of the vehicle.
+     * @return VehicleKind enum value.
+     */
+    virtual VehicleKind getKind() const = 0;
+
     // Getters
     /**
      * @brief Get the registration number.
-     * @return Registration number string.
+     * @return Reference to the registration number (no copy).
      */
-    std::string getRegNumber() const { return regNumber; }
+    const std::string& getRegNumber() const { return regNumber; }
 
     /**
      * @brief Get the brand.
-     * @return Brand name.
+     * @return Reference to the brand name (no copy).
      */
-    std::string getBrand() const { return brand; }
+    const std::string& getBrand() const { return brand; }
 
     /**
      * @brief Get the model.
-     * @return Model name.
+     * @return Reference to the model name (no copy).
      */
-    std::string getModel() const { return model; }
+    const std::string& getModel() const { return model; }
 
     /**
      * @brief Get the current mileage.
@@ -128,9 +187,12 @@ public:
     /**
      * @brief Set the new mileage.
      * @param newMileage New mileage value.
-     * @throws std::invalid_argument If new mileage is negative or less than current.
+     * @throws std::invalid_argument If new mileage is not finite, negative or less than current.
      */
     void setMileage(double newMileage) {
+        if (!std::isfinite(newMileage)) {
+            throw std::invalid_argument("Mileage must be a finite number.");
+        }
         if (newMileage < 0) {
             throw std::invalid_argument("Mileage cannot be negative.");
         }
@@ -138,20 +200,31 @@ public:
             throw std::invalid_argument("New mileage cannot be lower than current mileage.");
         }
         mileage = newMileage;
+        notifyChanged();
     }
 
     /**
      * @brief Change the base cost.
      * @param newCost New daily cost involved.
-     * @throws std::invalid_argument If new cost is non-positive.
+     * @throws std::invalid_argument If new cost is not finite or non-positive.
      */
     void setBaseCost(double newCost) {
+        if (!std::isfinite(newCost)) {
+            throw std::invalid_argument("Base cost must be a finite number.");
+        }
         if (newCost <= 0) {
             throw std::invalid_argument("Base cost must be positive.");
         }
         baseCost = newCost;
+        notifyChanged();
     }
 
+    /**
+     * @brief Attach an observer notified by the setters.
+     * @param obs Observer or nullptr to detach (not owned).
+     */
+    void setObserver(VehicleObserver* obs) { observer = obs; }
+
     // --- Operators ---
 
     /**
@@ -0,0 +1,359 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "CombustionVehicle.hpp"
+#include "FleetColumns.hpp"
+#include "Bitset.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BK_FILTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang need the AVX2 kernels compiled for AVX2 explicitly; MSVC accepts the intrinsics as is.
+#if defined(BK_FILTER_X86) && defined(__GNUC__)
+#define BK_FILTER_AVX2 __attribute__((target("avx2")))
+#else
+#define BK_FILTER_AVX2
+#endif
+
+namespace bk {
+
+/**
+ * @class VehicleFilter
+ * @brief Conjunction of column predicates evaluated over FleetColumns.
+ *
+ * Each predicate is evaluated 64 rows at a time into a selection bitmap and
+ * ANDed with the previous ones. The kernels use AVX2 or SSE2 when the CPU
+ * supports it (detected at runtime) and a scalar loop otherwise; all levels
+ * produce identical bitmaps.
+ */
+class VehicleFilter {
+public:
+    /**
+     * @enum Column
+     * @brief Column a predicate applies to.
+     */
+    enum class Column {
+        BaseCost,
+        Mileage,
+        EngineSize,
+        FuelConsumption,
+        BatteryCapacity,
+        CargoCapacity,
+        Licence,
+        Kind,
+        FuelType
+    };
+
+    /**
+     * @enum Op
+     * @brief Comparison between the column value and the predicate value.
+     */
+    enum class Op {
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal
+    };
+
+    /**
+     * @enum SimdLevel
+     * @brief Instruction set used by the kernels.
+     */
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief Single "column op value" condition.
+     */
+    struct Predicate {
+        Column column;
+        Op op;
+        double value;
+    };
+
+private:
+    std::vector<Predicate> predicates; ///< All must hold
+    bool availableOnly = false;        ///< Also require the vehicle not to be rented
+
+    static bool compare(double x, Op op, double v) {
+        switch (op) {
+            case Op::Less: return x < v;
+            case Op::LessEqual: return x <= v;
+            case Op::Greater: return x > v;
+            case Op::GreaterEqual: return x >= v;
+            case Op::Equal: return x == v;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Scalar kernel: AND the predicate into words for rows [from, n).
+     * @param from First row (multiple of 64).
+     */
+    template <typename T>
+    static void andScalar(const T* col, std::size_t from, std::size_t n, Op op, double v,
+                          std::uint64_t* words) {
+        for (std::size_t base = from; base < n; base += 64) {
+            std::size_t end = std::min(n, base + 64);
+            std::uint64_t m = 0;
+            for (std::size_t i = base; i < end; ++i) {
+                m |= std::uint64_t{compare(static_cast<double>(col[i]), op, v)} << (i - base);
+            }
+            words[base / 64] &= m;
+        }
+    }
+
+#ifdef BK_FILTER_X86
+    // --- SSE2 kernels (2 doubles / 16 bytes per step) ---
+
+    static __m128d loadSse2(const double* p) { return _mm_loadu_pd(p); }
+    static __m128d loadSse2(const std::int32_t* p) {
+        return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+    }
+
+    template <Op O>
+    static __m128d cmpSse2(__m128d x, __m128d v) {
+        if constexpr (O == Op::Less) return _mm_cmplt_pd(x, v);
+        else if constexpr (O == Op::LessEqual) return _mm_cmple_pd(x, v);
+        else if constexpr (O == Op::Greater) return _mm_cmpgt_pd(x, v);
+        else if constexpr (O == Op::GreaterEqual) return _mm_cmpge_pd(x, v);
+        else return _mm_cmpeq_pd(x, v);
+    }
+
+    template <Op O, typename T>
+    static void andSse2(const T* col, std::size_t n, double value, std::uint64_t* words) {
+        const __m128d v = _mm_set1_pd(value);
+        std::size_t full = n / 64 * 64;
+        for (std::size_t base = 0; base < full; base += 64) {
+            std::uint64_t m = 0;
+            for (int j = 0; j < 64; j += 2) {
+                __m128d c = cmpSse2<O>(loadSse2(col + base + j), v);
+                m |= static_cast<std::uint64_t>(_mm_movemask_pd(c)) << j;
+            }
+            words[base / 64] &= m;
+        }
+        andScalar(col, full, n, O, value, words);
+    }
+
+    static void andBytesEqualSse2(const std::uint8_t* col, std::size_t n, std::uint8_t value,
+                                  std::uint64_t* words) {
+        const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+        std::size_t full = n / 64 * 64;
+        for (std::size_t base = 0; base < full; base += 64) {
+            std::uint64_t m = 0;
+            for (int j = 0; j < 64; j += 16) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col + base + j));
+                auto bits = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, v)));
+                m |= static_cast<std::uint64_t>(bits) << j;
+            }
+            words[base / 64] &= m;
+        }
+        andScalar(col, full, n, Op::Equal, value, words);
+    }
+
+    // --- AVX2 kernels (4 doubles / 32 bytes per step) ---
+
+    BK_FILTER_AVX2 static __m256d loadAvx2(const double* p) { return _mm256_loadu_pd(p); }
+    BK_FILTER_AVX2 static __m256d loadAvx2(const std::int32_t* p) {
+        return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+
+    template <Op O>
+    BK_FILTER_AVX2 static __m256d cmpAvx2(__m256d x, __m256d v) {
+        if constexpr (O == Op::Less) return _mm256_cmp_pd(x, v, _CMP_LT_OQ);
+        else if constexpr (O == Op::LessEqual) return _mm256_cmp_pd(x, v, _CMP_LE_OQ);
+        else if constexpr (O == Op::Greater) return _mm256_cmp_pd(x, v, _CMP_GT_OQ);
+        else if constexpr (O == Op::GreaterEqual) return _mm256_cmp_pd(x, v, _CMP_GE_OQ);
+        else return _mm256_cmp_pd(x, v, _CMP_EQ_OQ);
+    }
+
+    template <Op O, typename T>
+    BK_FILTER_AVX2 static void andAvx2(const T* col, std::size_t n, double value, std::uint64_t* words) {
+        const __m256d v = _mm256_set1_pd(value);
+        std::size_t full = n / 64 * 64;
+        for (std::size_t base = 0; base < full; base += 64) {
+            std::uint64_t m = 0;
+            for (int j = 0; j < 64; j += 4) {
+                __m256d c = cmpAvx2<O>(loadAvx2(col + base + j), v);
+                m |= static_cast<std::uint64_t>(_mm256_movemask_pd(c)) << j;
+            }
+            words[base / 64] &= m;
+        }
+        andScalar(col, full, n, O, value, words);
+    }
+
+    BK_FILTER_AVX2 static void andBytesEqualAvx2(const std::uint8_t* col, std::size_t n, std::uint8_t value,
+                                                 std::uint64_t* words) {
+        const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+        std::size_t full = n / 64 * 64;
+        for (std::size_t base = 0; base < full; base += 64) {
+            std::uint64_t m = 0;
+            for (int j = 0; j < 64; j += 32) {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + base + j));
+                auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, v)));
+                m |= static_cast<std::uint64_t>(bits) << j;
+            }
+            words[base / 64] &= m;
+        }
+        andScalar(col, full, n, Op::Equal, value, words);
+    }
+
+    template <Op O, typename T>
+    static void andVector(const T* col, std::size_t n, double value, std::uint64_t* words, SimdLevel level) {
+        if (level == SimdLevel::AVX2) andAvx2<O>(col, n, value, words);
+        else andSse2<O>(col, n, value, words);
+    }
+
+    static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif // BK_FILTER_X86
+
+    /**
+     * @brief AND one predicate over a numeric column into the selection words.
+     */
+    template <typename T>
+    static void apply(const T* col, std::size_t n, Op op, double value, std::uint64_t* words, SimdLevel level) {
+#ifdef BK_FILTER_X86
+        if (level != SimdLevel::Scalar) {
+            switch (op) {
+                case Op::Less: andVector<Op::Less>(col, n, value, words, level); return;
+                case Op::LessEqual: andVector<Op::LessEqual>(col, n, value, words, level); return;
+                case Op::Greater: andVector<Op::Greater>(col, n, value, words, level); return;
+                case Op::GreaterEqual: andVector<Op::GreaterEqual>(col, n, value, words, level); return;
+                case Op::Equal: andVector<Op::Equal>(col, n, value, words, level); return;
+            }
+        }
+#endif
+        andScalar(col, 0, n, op, value, words);
+    }
+
+    /**
+     * @brief AND one predicate over a byte column (enum codes) into the selection words.
+     * Only equality against a byte value is vectorized; other comparisons are rare here.
+     */
+    static void apply(const std::uint8_t* col, std::size_t n, Op op, double value, std::uint64_t* words,
+                      SimdLevel level) {
+#ifdef BK_FILTER_X86
+        auto byte = static_cast<std::uint8_t>(value);
+        if (level != SimdLevel::Scalar && op == Op::Equal && value >= 0 && value <= 255 && byte == value) {
+            if (level == SimdLevel::AVX2) andBytesEqualAvx2(col, n, byte, words);
+            else andBytesEqualSse2(col, n, byte, words);
+            return;
+        }
+#endif
+        andScalar(col, 0, n, op, value, words);
+    }
+
+public:
+    /**
+     * @brief Best instruction set supported by the CPU (detected once).
+     */
+    static SimdLevel detectSimdLevel() {
+#ifdef BK_FILTER_X86
+        static const SimdLevel level = cpuHasAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    /**
+     * @brief Add a condition "column op value".
+     * @return Reference to this filter for chaining.
+     */
+    VehicleFilter& where(Column column, Op op, double value) {
+        predicates.push_back({column, op, value});
+        return *this;
+    }
+
+    /**
+     * @brief Require the given licence category.
+     */
+    VehicleFilter& licence(Vehicle::LicenceCategory cat) {
+        return where(Column::Licence, Op::Equal, static_cast<int>(cat));
+    }
+
+    /**
+     * @brief Require the given vehicle kind.
+     */
+    VehicleFilter& kind(Vehicle::VehicleKind k) {
+        return where(Column::Kind, Op::Equal, static_cast<int>(k));
+    }
+
+    /**
+     * @brief Require the given fuel type (excludes electric vehicles).
+     */
+    VehicleFilter& fuelType(CombustionVehicle::FuelType type) {
+        return where(Column::FuelType, Op::Equal, static_cast<int>(type));
+    }
+
+    /**
+     * @brief Require the vehicle not to be rented (applied by VehicleManager).
+     */
+    VehicleFilter& available() {
+        availableOnly = true;
+        return *this;
+    }
+
+    bool requiresAvailable() const { return availableOnly; }
+    const std::vector<Predicate>& getPredicates() const { return predicates; }
+
+    /**
+     * @brief Evaluate the conjunction over all rows.
+     * @param cols Columns to scan.
+     * @param level Instruction set to use (defaults to the best supported one).
+     * @return Bitmap with one bit per row, set for live rows matching every predicate.
+     */
+    Bitset evaluate(const FleetColumns& cols, SimdLevel level = detectSimdLevel()) const {
+        std::size_t n = cols.size();
+        Bitset selection;
+        selection.resize(n);
+        selection.setAll();
+        std::uint64_t* words = selection.data().data();
+
+        apply(cols.getLive().data(), n, Op::Equal, 1, words, level);
+        for (const auto& p : predicates) {
+            switch (p.column) {
+                case Column::BaseCost: apply(cols.getBaseCosts().data(), n, p.op, p.value, words, level); break;
+                case Column::Mileage: apply(cols.getMileages().data(), n, p.op, p.value, words, level); break;
+                case Column::EngineSize: apply(cols.getEngineSizes().data(), n, p.op, p.value, words, level); break;
+                case Column::FuelConsumption: apply(cols.getFuelConsumptions().data(), n, p.op, p.value, words, level); break;
+                case Column::BatteryCapacity: apply(cols.getBatteryCapacities().data(), n, p.op, p.value, words, level); break;
+                case Column::CargoCapacity: apply(cols.getCargoCapacities().data(), n, p.op, p.value, words, level); break;
+                case Column::Licence: apply(cols.getLicences().data(), n, p.op, p.value, words, level); break;
+                case Column::Kind: apply(cols.getKinds().data(), n, p.op, p.value, words, level); break;
+                case Column::FuelType: apply(cols.getFuelTypes().data(), n, p.op, p.value, words, level); break;
+            }
+        }
+        return selection;
+    }
+};
+
+} // namespace bk
@@ -7,12 +7,45 @@
 #include "ElectricCar.hpp"
 #include "Truck.hpp"
 #include "Motorcycle.hpp"
+#include "HashIndex.hpp"
+#include "Bitset.hpp"
+#include "FleetColumns.hpp"
+#include "VehicleFilter.hpp"
+#include "VehicleQuery.hpp"
+#include "PriceIndex.hpp"
+#include "Snapshot.hpp"
+#include "MappedFile.hpp"
+#include "TextReader.hpp"
+#include "ThreadPool.hpp"
+#include "Journal.hpp"
+#include "Checkpointer.hpp"
+#include "Date.hpp"
+#include "RentalHistory.hpp"
+#include "HistoryLog.hpp"
+#include "RentalStats.hpp"
+#include "BookingCalendar.hpp"
+#include "AvailabilitySweep.hpp"
+#include "DueQueue.hpp"
+#include "MaintenanceSchedule.hpp"
 
 #include <vector>
+#include <array>
+#include <memory>
+#include <future>
+#include <cstdio>
+#include <random>
+#include <chrono>
+#include <cmath>
 #include <string>
+#include <string_view>
+#include <limits>
 #include <algorithm> // to edit vectors
 #include <iostream>
 #include <fstream> // to save to file
+#include <iterator>
+#include <map>
+#include <optional>
+#include <utility>
 #include <sstream> 
 
 namespace bk {
@@ -21,628 +54,2558 @@ namespace bk {
  * @class VehicleManager
  * @brief Central class for managing Vehicles, Customers, and Rentals.
  */
-class VehicleManager {
+class VehicleManager : private VehicleObserver, private RentalObserver {
 private:
-    std::vector<Vehicle*> vehicles;   // Container for all vehicles
-    std::vector<Customer*> customers; // Container for all customers
+    std::vector<std::size_t> vehicleOrder;  // Vehicle slot IDs in insertion order
+    std::vector<std::size_t> customerOrder; // Customer slot IDs in insertion order
     std::vector<Rental*> rentals;     // Container for active rentals
-    std::vector<std::string> rentalHistory; // Archive of past rentals
+    RentalHistory rentalHistory;      // Archive of past rentals (only the tail if historyLog is open)
+    std::array<std::vector<std::size_t>, Vehicle::kindCount> slotsByKind; // Slot IDs partitioned by VehicleKind
+    std::array<std::vector<std::size_t>, customerTypeCount> customersByType; // Customer slot IDs partitioned by CustomerType
+    mutable std::vector<Vehicle*> slots; // Slot ID -> vehicle (nullptr if the slot is free or not built yet)
+    mutable std::vector<std::string_view> vehicleRecords; // Slot ID -> mapped snapshot record of a vehicle not built yet
+    std::vector<std::size_t> freeSlots; // Slot IDs released by removed vehicles
+    mutable std::vector<Customer*> customerSlots; // Customer slot ID -> customer (nullptr if free or not built yet)
+    mutable std::vector<std::string_view> customerRecords; // Customer slot ID -> mapped snapshot record of a customer not built yet
+    std::vector<std::size_t> freeCustomerSlots; // Customer slot IDs released by removed customers
+    Bitset availableSlots;            // Bit per slot, set if the vehicle is not rented and not due for service
+    FleetColumns columns;             // Numeric vehicle attributes by slot ID
+    PriceIndex priceIndex;            // Slot IDs ordered by base cost
+    PriceIndex availablePrices;       // Slot IDs of available vehicles ordered by base cost
+    HashIndex<std::size_t> vehicleIndex; // Registration number -> slot ID
+    HashIndex<std::vector<std::size_t>> brandIndex; // Brand -> slot IDs
+    HashIndex<std::size_t> customerIndex; // Customer ID (ID card / NIP) -> customer slot ID
+    HashIndex<std::size_t> rentalByVehicle; // Registration number -> position in rentals
+    HashIndex<std::vector<Rental*>> rentalsByCustomer; // Customer ID -> active rentals
+    DueQueue rentalsByEnd;            // Slot IDs of rented vehicles by rental end day
+    BookingCalendar reservations;     // Future bookings by slot ID
+    HashIndex<std::size_t> reservationsByCustomer; // Customer ID -> number of reservations
+    MaintenanceSchedule maintenance;  // Service due tracking by slot ID
+    mutable std::unique_ptr<MappedFile> mappedSnapshot; // Snapshot holding the records not built yet
+    std::string mappedSnapshotFile;   // Path of mappedSnapshot
+    std::unique_ptr<Journal> journal; // Log of mutating operations since the last save (nullptr if disabled)
+    std::unique_ptr<Checkpointer> checkpointer; // Background checkpoint writer (nullptr if disabled)
+    std::unique_ptr<HistoryLog> historyLog; // Sealed history segments (nullptr if history is kept in memory)
+    mutable RentalStats rentalStats;  // Rollups of the whole history (built on first use)
+    mutable bool rentalStatsValid = false; // rentalStats matches the history
+    std::uint8_t dirtySections = allSections; // Bit per Checkpointer::Section changed since the last checkpoint
+    bool inOperation = false;         // Setters are called by an operation that is journaled as a whole
+
+    static constexpr std::uint8_t allSections = (1u << Checkpointer::sectionCount) - 1;
 
     /**
      * @brief Helper to check if a vehicle registration number is unique.
      */
-    bool isRegNumberUnique(const std::string& regNumber) const {
-        for (const auto* v : vehicles) {
-            if (v->getRegNumber() == regNumber) return false;
-        }
-        return true;
+    bool isRegNumberUnique(std::string_view regNumber) const {
+        return !vehicleIndex.contains(regNumber);
     }
 
     /**
      * @brief Helper to check if a customer ID is unique.
      */
-    bool isCustomerIdUnique(const std::string& id) const {
-        for (const auto* c : customers) {
-            if (c->getId() == id) return false;
+    bool isCustomerIdUnique(std::string_view id) const {
+        return !customerIndex.contains(id);
+    }
+
+    /**
+     * @brief Get the slot ID of a vehicle known to be in the system.
+     */
+    std::size_t slotOf(const Vehicle* v) const {
+        return *vehicleIndex.find(v->getRegNumber());
+    }
+
+    /**
+     * @brief Get a vehicle slot ID, reusing released slots first.
+     */
+    std::size_t reserveSlot() {
+        if (!freeSlots.empty()) {
+            std::size_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
         }
-        return true;
+        slots.push_back(nullptr);
+        vehicleRecords.emplace_back();
+        availableSlots.resize(slots.size());
+        return slots.size() - 1;
     }
 
-public:
     /**
-     * @brief Constructor.
+     * @brief Add an occupied slot to every vehicle index.
      */
-    VehicleManager() = default;
+    void indexSlot(std::size_t slot, std::string_view regNumber, std::string_view brand,
+                   const FleetColumns::Row& row) {
+        markDirty(Checkpointer::Section::Vehicles);
+        vehicleOrder.push_back(slot);
+        vehicleIndex.insert(regNumber, slot);
+        columns.store(slot, row);
+        priceIndex.insert(row.baseCost, slot);
+        maintenance.add(slot, static_cast<Vehicle::VehicleKind>(row.kind), row.mileage);
+        markDirty(Checkpointer::Section::Maintenance);
+        setAvailable(slot, !maintenance.isDue(slot));
+
+        slotsByKind[row.kind].push_back(slot);
+        auto* sameBrand = brandIndex.find(brand);
+        if (sameBrand) {
+            sameBrand->push_back(slot);
+        } else {
+            brandIndex.insert(brand, std::vector<std::size_t>{slot});
+        }
+    }
 
     /**
-     * @brief Destructor.
+     * @brief Mark a slot as available or not, keeping availablePrices in sync.
+     * The slot's base cost must already be in the columns.
      */
-    ~VehicleManager() {
-        for (auto* r : rentals) delete r;
-        rentals.clear();
+    void setAvailable(std::size_t slot, bool available) {
+        if (availableSlots.test(slot) == available) return;
+        double cost = columns.getBaseCosts()[slot];
+        if (available) {
+            availableSlots.set(slot);
+            availablePrices.insert(cost, slot);
+        } else {
+            availableSlots.reset(slot);
+            availablePrices.erase(cost, slot);
+        }
+    }
 
-        for (auto* v : vehicles) delete v;
-        vehicles.clear();
+    /**
+     * @brief Recompute whether a vehicle can be rented after its rental or service state changed.
+     */
+    void refreshAvailability(std::size_t slot, bool rented) {
+        setAvailable(slot, !rented && !maintenance.isDue(slot));
+    }
 
-        for (auto* c : customers) delete c;
-        customers.clear();
+    /**
+     * @brief Clear the bits of the slots that are due for service.
+     */
+    void removeDueForService(Bitset& slotIds) const {
+        maintenance.forEachDueWithin(0.0, [&](std::size_t slot, double) {
+            if (slot < slotIds.size()) slotIds.reset(slot);
+        });
     }
 
-    // --- Vehicle Management ---
+    /**
+     * @brief Give a vehicle a slot ID and index it.
+     */
+    std::size_t allocateSlot(Vehicle* v) {
+        std::size_t slot = reserveSlot();
+        slots[slot] = v;
+        v->setObserver(this);
+        indexSlot(slot, v->getRegNumber(), v->getBrand(), FleetColumns::rowOf(*v));
+        return slot;
+    }
 
     /**
-     * @brief Add a new vehicle to the system.
-     * @param v Raw pointer to the vehicle (takes ownership).
-     * @throws std::invalid_argument If vehicle is null or regNumber not unique.
+     * @brief Release the slot of a removed vehicle (the vehicle must be built).
      */
-    void addVehicle(Vehicle* v) {
-        if (!v) throw std::invalid_argument("Vehicle cannot be null.");
-        if (!isRegNumberUnique(v->getRegNumber())) {
-            throw std::invalid_argument("Vehicle with this registration number already exists.");
-        }
-        vehicles.push_back(v);
+    void releaseSlot(std::size_t slot) {
+        markDirty(Checkpointer::Section::Vehicles);
+        Vehicle* v = slots[slot];
+        auto& part = slotsByKind[static_cast<int>(v->getKind())];
+        part.erase(std::find(part.begin(), part.end(), slot));
+        auto* sameBrand = brandIndex.find(v->getBrand());
+        sameBrand->erase(std::find(sameBrand->begin(), sameBrand->end(), slot));
+        if (sameBrand->empty()) brandIndex.erase(v->getBrand());
+        vehicleOrder.erase(std::find(vehicleOrder.begin(), vehicleOrder.end(), slot));
+        vehicleIndex.erase(v->getRegNumber());
+
+        v->setObserver(nullptr);
+        slots[slot] = nullptr;
+        vehicleRecords[slot] = {};
+        setAvailable(slot, false);
+        priceIndex.erase(columns.getBaseCosts()[slot], slot);
+        columns.erase(slot);
+        maintenance.remove(slot);
+        markDirty(Checkpointer::Section::Maintenance);
+        freeSlots.push_back(slot);
     }
 
     /**
-     * @brief Remove a vehicle by registration number.
+     * @brief Get the vehicle in a slot, building it from its snapshot record on first access.
+     * @return Raw pointer to vehicle or nullptr if the slot is free.
      */
-    void removeVehicle(const std::string& regNumber) {
-        for (const auto* r : rentals) {
-            if (r->getVehicle()->getRegNumber() == regNumber) {
-                throw std::invalid_argument("Cannot remove vehicle that is currently rented.");
-            }
+    Vehicle* vehicleAt(std::size_t slot) const {
+        Vehicle* v = slots[slot];
+        if (!v && !vehicleRecords[slot].empty()) {
+            std::string_view record = vehicleRecords[slot];
+            v = Snapshot::readVehicle(BinaryReader(record.data(), record.size()));
+            // Building a vehicle does not change the logical state, only the manager's cache
+            v->setObserver(const_cast<VehicleManager*>(this));
+            slots[slot] = v;
         }
+        return v;
+    }
 
-        auto i = std::remove_if(vehicles.begin(), vehicles.end(),
-            [&regNumber](Vehicle* v) {
-                if (v->getRegNumber() == regNumber) {
-                    delete v; // Free memory
-                    return true;
-                }
-                return false;
-            });
-        
-        if (i != vehicles.end()) {
-            vehicles.erase(i, vehicles.end());
-        } else {
-            throw std::invalid_argument("Vehicle not found.");
+    /**
+     * @brief Get a customer slot ID, reusing released slots first.
+     */
+    std::size_t reserveCustomerSlot() {
+        if (!freeCustomerSlots.empty()) {
+            std::size_t slot = freeCustomerSlots.back();
+            freeCustomerSlots.pop_back();
+            return slot;
         }
+        customerSlots.push_back(nullptr);
+        customerRecords.emplace_back();
+        return customerSlots.size() - 1;
     }
 
     /**
-     * @brief Find a vehicle by registration number.
-     * @return Raw pointer to vehicle or nullptr if not found.
+     * @brief Add an occupied customer slot to every customer index.
      */
-    Vehicle* getVehicle(const std::string& regNumber) const {
-        for (auto* v : vehicles) {
-            if (v->getRegNumber() == regNumber) return v;
-        }
-        return nullptr;
+    void indexCustomerSlot(std::size_t slot, std::string_view id, CustomerType type) {
+        markDirty(Checkpointer::Section::Customers);
+        customerOrder.push_back(slot);
+        customersByType[static_cast<int>(type)].push_back(slot);
+        customerIndex.insert(id, slot);
     }
 
     /**
-     * @brief Find vehicles by brand.
-     * @return Vector of matching vehicles.
+     * @brief Get the customer in a slot, building it from its snapshot record on first access.
+     * @return Raw pointer to customer or nullptr if the slot is free.
      */
-    std::vector<Vehicle*> findVehiclesByBrand(const std::string& brand) const {
-        std::vector<Vehicle*> matches;
-        for (auto* v : vehicles) {
-            if (v->getBrand() == brand) {
-                matches.push_back(v);
-            }
+    Customer* customerAt(std::size_t slot) const {
+        Customer* c = customerSlots[slot];
+        if (!c && !customerRecords[slot].empty()) {
+            std::string_view record = customerRecords[slot];
+            c = Snapshot::readCustomer(BinaryReader(record.data(), record.size()));
+            customerSlots[slot] = c;
         }
-        return matches;
+        return c;
     }
 
     /**
-     * @brief Find vehicles with base price <= maxPrice.
+     * @brief Build every object still in the mapped snapshot and unmap it (no-op if nothing is mapped).
+     * Needed before the file is replaced: Windows cannot replace a mapped file.
      */
-    std::vector<Vehicle*> findVehiclesByPrice(double maxPrice) const {
-        std::vector<Vehicle*> matches;
-        for (auto* v : vehicles) {
-            if (v->getBaseCost() <= maxPrice) {
-                matches.push_back(v);
-            }
-        }
-        return matches;
+    void releaseMappedSnapshot() const {
+        if (!mappedSnapshot) return;
+        for (std::size_t slot : vehicleOrder) vehicleAt(slot);
+        for (std::size_t slot : customerOrder) customerAt(slot);
+        vehicleRecords.assign(vehicleRecords.size(), {});
+        customerRecords.assign(customerRecords.size(), {});
+        mappedSnapshot.reset();
     }
 
     /**
-     * @brief Find vehicles that are NOT currently rented.
+     * @brief Keep the columnar copy and the price index in sync when a vehicle setter is called,
+     * and journal the new vehicle record unless the change is part of a journaled operation.
+     * The columns still hold the previous values when this runs.
      */
-    std::vector<Vehicle*> findAvailableVehicles() const {
-        std::vector<Vehicle*> available;
-        for (auto* v : vehicles) {
-            bool isRented = false;
-            for (const auto* r : rentals) {
-                if (r->getVehicle() == v) {
-                    isRented = true;
-                    break;
-                }
-            }
-            if (!isRented) {
-                available.push_back(v);
-            }
+    void onVehicleChanged(const Vehicle& v) override {
+        std::size_t slot = slotOf(&v);
+        double oldCost = columns.getBaseCosts()[slot];
+        if (oldCost != v.getBaseCost()) {
+            priceIndex.update(oldCost, v.getBaseCost(), slot);
+            if (availableSlots.test(slot)) availablePrices.update(oldCost, v.getBaseCost(), slot);
         }
-        return available;
+        columns.store(slot, v);
+        maintenance.setMileage(slot, v.getMileage());
+        refreshAvailability(slot, isRented(v.getRegNumber()));
+        markDirty(Checkpointer::Section::Vehicles);
+        if (inOperation) return;
+        logOperation(Journal::Op::UpdateVehicle, [&](BinaryWriter& out) { Snapshot::writeVehicle(out, v); });
     }
 
     /**
-     * @brief Display all vehicles.
+     * @brief Copy the attributes that have setters onto a vehicle of the same kind.
+     * @throws std::invalid_argument If a value fails validation or the mileage would decrease.
      */
-    void showAllVehicles() const {
-        if (vehicles.empty()) {
-            std::cout << "No vehicles in the system.\n";
+    static void assignVehicle(Vehicle& to, const Vehicle& from) {
+        to.setBaseCost(from.getBaseCost());
+        if (from.getMileage() != to.getMileage()) to.setMileage(from.getMileage());
+        if (from.getKind() == Vehicle::VehicleKind::ElectricCar) {
+            auto& car = static_cast<ElectricCar&>(to);
+            const auto& src = static_cast<const ElectricCar&>(from);
+            car.setBatteryCapacity(src.getBatteryCapacity());
+            car.setDoors(src.getDoors());
             return;
         }
-        for (const auto* v : vehicles) {
-            std::cout << *v << "\n-----------------\n";
+        auto& combustion = static_cast<CombustionVehicle&>(to);
+        const auto& src = static_cast<const CombustionVehicle&>(from);
+        combustion.setEngineSize(src.getEngineSize());
+        combustion.setFuelConsumption(src.getFuelConsumption());
+        combustion.setFuelType(src.getFuelType());
+        if (from.getKind() == Vehicle::VehicleKind::CombustionCar) {
+            static_cast<CombustionCar&>(to).setDoors(static_cast<const CombustionCar&>(from).getDoors());
+        } else if (from.getKind() == Vehicle::VehicleKind::Truck) {
+            static_cast<Truck&>(to).setCargoCapacity(static_cast<const Truck&>(from).getCargoCapacity());
         }
     }
 
-    void showCars() const {
-        bool found = false;
-        for (const auto* v : vehicles) {
-            if (dynamic_cast<const CombustionCar*>(v) || dynamic_cast<const ElectricCar*>(v)) {
-                std::cout << *v << "\n-----------------\n";
-                found = true;
-            }
-        }
-        if (!found) std::cout << "No cars found.\n";
+    /**
+     * @brief Move a rental in the due queue when its end date is changed, and journal the change.
+     */
+    void onRentalChanged(const Rental& r) override {
+        rentalsByEnd.set(slotOf(r.getVehicle()), r.getEndDay());
+        markDirty(Checkpointer::Section::Rentals);
+        logOperation(Journal::Op::SetEndDate, [&](BinaryWriter& out) {
+            out.putString(r.getVehicle()->getRegNumber());
+            out.putString(r.getEndDate());
+        });
     }
 
-    void showCombustionCars() const {
-        bool found = false;
-        for (const auto* v : vehicles) {
-            if (dynamic_cast<const CombustionCar*>(v)) {
-                std::cout << *v << "\n-----------------\n";
-                found = true;
-            }
-        }
-        if (!found) std::cout << "No combustion cars found.\n";
+    /**
+     * @brief Active rentals of the vehicles due before a day, earliest end first.
+     * @param fromDay Rentals ending before this day are skipped (still visited).
+     */
+    std::vector<Rental*> rentalsEndingBefore(int day, int fromDay) const {
+        std::vector<Rental*> result;
+        rentalsByEnd.forEachDueBefore(day, [&](const DueQueue::Entry& e) {
+            if (e.dueDay >= fromDay) result.push_back(getActiveRental(vehicleAt(e.slot)->getRegNumber()));
+        });
+        return result;
     }
 
-    void showElectricCars() const {
-        bool found = false;
-        for (const auto* v : vehicles) {
-            if (dynamic_cast<const ElectricCar*>(v)) {
-                std::cout << *v << "\n-----------------\n";
-                found = true;
-            }
-        }
-        if (!found) std::cout << "No electric cars found.\n";
+    /**
+     * @brief Map slot IDs to vehicles.
+     */
+    std::vector<Vehicle*> vehiclesAt(const std::vector<std::size_t>& slotIds) const {
+        std::vector<Vehicle*> result;
+        result.reserve(slotIds.size());
+        for (std::size_t slot : slotIds) result.push_back(vehicleAt(slot));
+        return result;
     }
 
-    void showMotorcycles() const {
-        bool found = false;
-        for (const auto* v : vehicles) {
-            if (dynamic_cast<const Motorcycle*>(v)) {
-                std::cout << *v << "\n-----------------\n";
-                found = true;
-            }
+    /**
+     * @brief Print all vehicles of one kind.
+     * @return true if at least one vehicle was printed.
+     */
+    bool showVehiclesOfKind(Vehicle::VehicleKind kind) const {
+        const auto& part = slotsByKind[static_cast<int>(kind)];
+        for (std::size_t slot : part) {
+            std::cout << *vehicleAt(slot) << "\n-----------------\n";
         }
-        if (!found) std::cout << "No motorcycles found.\n";
+        return !part.empty();
     }
 
-    void showTrucks() const {
-        bool found = false;
-        for (const auto* v : vehicles) {
-            if (dynamic_cast<const Truck*>(v)) {
-                std::cout << *v << "\n-----------------\n";
-                found = true;
-            }
+    /**
+     * @brief Print all customers of one type.
+     * @return true if at least one customer was printed.
+     */
+    bool showCustomersOfType(CustomerType type) const {
+        const auto& part = customersByType[static_cast<int>(type)];
+        for (std::size_t slot : part) {
+            std::cout << *customerAt(slot) << "\n-----------------\n";
         }
-        if (!found) std::cout << "No trucks found.\n";
+        return !part.empty();
     }
 
-    // --- Customer Management ---
-
     /**
-     * @brief Add a new customer to the system.
-     * @param c Raw pointer to the customer.
-     * @throws std::invalid_argument If customer is null or ID not unique.
+     * @brief Delete all vehicles, customers and rentals and reset every index.
      */
-    void addCustomer(Customer* c) {
-        if (!c) throw std::invalid_argument("Customer cannot be null.");
-        if (!isCustomerIdUnique(c->getId())) {
-            throw std::invalid_argument("Customer with this ID already exists.");
-        }
-        customers.push_back(c);
+    void clearAll() {
+        // The journal and checkpoints no longer match the state
+        checkpointer.reset();
+        journal.reset();
+        dirtySections = allSections;
+        for (auto* r : rentals) delete r;
+        rentals.clear();
+        for (auto* v : slots) delete v;
+        slots.clear();
+        vehicleRecords.clear();
+        vehicleOrder.clear();
+        freeSlots.clear();
+        for (auto* c : customerSlots) delete c;
+        customerSlots.clear();
+        customerRecords.clear();
+        customerOrder.clear();
+        freeCustomerSlots.clear();
+        rentalHistory.clear();
+        if (historyLog) historyLog->assign({});
+        rentalStats.clear();
+        rentalStatsValid = false;
+
+        availableSlots.clear();
+        availablePrices.clear();
+        columns.clear();
+        priceIndex.clear();
+        vehicleIndex.clear();
+        brandIndex.clear();
+        customerIndex.clear();
+        for (auto& part : slotsByKind) part.clear();
+        for (auto& part : customersByType) part.clear();
+        rentalByVehicle.clear();
+        rentalsByCustomer.clear();
+        rentalsByEnd.clear();
+        reservations.clear();
+        reservationsByCustomer.clear();
+        maintenance.clear();
+        mappedSnapshot.reset();
     }
 
     /**
-     * @brief Remove a customer by ID.
+     * @brief Pre-size vehicle containers before a bulk load.
      */
-    void removeCustomer(const std::string& id) {
-        for (const auto* r : rentals) {
-            if (r->getCustomer()->getId() == id) {
-                throw std::invalid_argument("Cannot remove customer who has active rentals.");
-            }
-        }
-
-        auto i = std::remove_if(customers.begin(), customers.end(),
-            [&id](Customer* c) {
-                if (c->getId() == id) {
-                    delete c; // Free memory
-                    return true;
-                }
-                return false;
-            });
+    void reserveVehicles(std::size_t n) {
+        vehicleIndex.reserve(n);
+        vehicleOrder.reserve(n);
+        slots.reserve(n);
+        vehicleRecords.reserve(n);
+        columns.reserve(n);
+    }
 
-        if (i != customers.end()) {
-            customers.erase(i, customers.end());
-        } else {
-            throw std::invalid_argument("Customer not found.");
-        }
+    /**
+     * @brief Pre-size customer containers before a bulk load.
+     */
+    void reserveCustomers(std::size_t n) {
+        customerIndex.reserve(n);
+        customerOrder.reserve(n);
+        customerSlots.reserve(n);
+        customerRecords.reserve(n);
     }
 
     /**
-     * @brief Find a customer by ID.
-     * @return Raw pointer to customer or nullptr if not found.
+     * @brief Replace the state with the one another manager loaded, leaving that manager empty.
+     * The journal, checkpointer and history log stay; they are reset like in clearAll.
      */
-    Customer* getCustomer(const std::string& id) const {
-        for (auto* c : customers) {
-            if (c->getId() == id) return c;
+    void adoptState(VehicleManager& from) {
+        clearAll();
+        std::swap(vehicleOrder, from.vehicleOrder);
+        std::swap(customerOrder, from.customerOrder);
+        std::swap(rentals, from.rentals);
+        std::swap(rentalHistory, from.rentalHistory);
+        std::swap(slotsByKind, from.slotsByKind);
+        std::swap(customersByType, from.customersByType);
+        std::swap(slots, from.slots);
+        std::swap(vehicleRecords, from.vehicleRecords);
+        std::swap(freeSlots, from.freeSlots);
+        std::swap(customerSlots, from.customerSlots);
+        std::swap(customerRecords, from.customerRecords);
+        std::swap(freeCustomerSlots, from.freeCustomerSlots);
+        std::swap(availableSlots, from.availableSlots);
+        std::swap(columns, from.columns);
+        std::swap(priceIndex, from.priceIndex);
+        std::swap(availablePrices, from.availablePrices);
+        std::swap(vehicleIndex, from.vehicleIndex);
+        std::swap(brandIndex, from.brandIndex);
+        std::swap(customerIndex, from.customerIndex);
+        std::swap(rentalByVehicle, from.rentalByVehicle);
+        std::swap(rentalsByCustomer, from.rentalsByCustomer);
+        std::swap(rentalsByEnd, from.rentalsByEnd);
+        std::swap(reservations, from.reservations);
+        std::swap(reservationsByCustomer, from.reservationsByCustomer);
+        std::swap(maintenance, from.maintenance);
+        std::swap(mappedSnapshot, from.mappedSnapshot);
+        std::swap(mappedSnapshotFile, from.mappedSnapshotFile);
+        std::swap(rentalStats, from.rentalStats);
+        std::swap(rentalStatsValid, from.rentalStatsValid);
+        for (auto* v : slots) {
+            if (v) v->setObserver(this);
         }
-        return nullptr;
+        for (auto* r : rentals) r->setObserver(this);
     }
 
     /**
-     * @brief Display all customers.
+     * @brief Register a new active rental in the rental indexes.
      */
-    void showAllCustomers() const {
-        if (customers.empty()) {
-            std::cout << "No customers in the system.\n";
-            return;
-        }
-        for (const auto* c : customers) {
-            std::cout << *c << "\n-----------------\n";
+    void linkRental(Rental* r) {
+        markDirty(Checkpointer::Section::Rentals);
+        rentalByVehicle.insert(r->getVehicle()->getRegNumber(), rentals.size());
+        rentals.push_back(r);
+        setAvailable(slotOf(r->getVehicle()), false);
+        rentalsByEnd.set(slotOf(r->getVehicle()), r->getEndDay());
+        r->setObserver(this);
+
+        const std::string& customerId = r->getCustomer()->getId();
+        auto* list = rentalsByCustomer.find(customerId);
+        if (list) {
+            list->push_back(r);
+        } else {
+            rentalsByCustomer.insert(customerId, std::vector<Rental*>{r});
         }
     }
 
-    void showPrivateCustomers() const {
-        bool found = false;
-        for (const auto* c : customers) {
-            if (dynamic_cast<const PrivateCustomer*>(c)) {
-                std::cout << *c << "\n-----------------\n";
-                found = true;
-            }
-        }
-        if (!found) std::cout << "No private customers found.\n";
+    /**
+     * @brief Remove an active rental from the rental indexes (does not delete it).
+     * The last rental is moved into the freed position.
+     */
+    void unlinkRental(Rental* r) {
+        markDirty(Checkpointer::Section::Rentals);
+        const std::string& regNumber = r->getVehicle()->getRegNumber();
+        std::size_t pos = *rentalByVehicle.find(regNumber);
+        Rental* last = rentals.back();
+        rentals[pos] = last;
+        *rentalByVehicle.find(last->getVehicle()->getRegNumber()) = pos;
+        rentals.pop_back();
+        rentalByVehicle.erase(regNumber);
+        refreshAvailability(slotOf(r->getVehicle()), false);
+        rentalsByEnd.erase(slotOf(r->getVehicle()));
+        r->setObserver(nullptr);
+
+        const std::string& customerId = r->getCustomer()->getId();
+        auto* list = rentalsByCustomer.find(customerId);
+        list->erase(std::find(list->begin(), list->end(), r));
+        if (list->empty()) rentalsByCustomer.erase(customerId);
     }
 
-    void showBusinessCustomers() const {
-        bool found = false;
-        for (const auto* c : customers) {
-            if (dynamic_cast<const BusinessCustomer*>(c)) {
-                std::cout << *c << "\n-----------------\n";
-                found = true;
-            }
+    /**
+     * @brief Count a new reservation of a customer.
+     */
+    void countReservation(const std::string& customerId) {
+        markDirty(Checkpointer::Section::Reservations);
+        auto* count = reservationsByCustomer.find(customerId);
+        if (count) {
+            ++*count;
+        } else {
+            reservationsByCustomer.insert(customerId, 1);
         }
-        if (!found) std::cout << "No business customers found.\n";
     }
 
-    // --- Rental Management ---
-
     /**
-     * @brief Create a rental transaction.
-     * @param regNumber Registration number of the vehicle.
-     * @param customerId ID of the customer.
-     * @param startDate Start date (YYYY-MM-DD).
-     * @param endDate End date (YYYY-MM-DD).
-     * @param showMessage If true, prints success message.
-     * @throws std::invalid_argument If vehicle/customer invalid or vehicle already rented.
+     * @brief Stop counting a removed reservation of a customer.
      */
-    void rentVehicle(const std::string& regNumber, const std::string& customerId, 
-                     const std::string& startDate, const std::string& endDate, 
-                     bool showMessage = true) {
-        Vehicle* v = getVehicle(regNumber);
-        if (!v) throw std::invalid_argument("Vehicle not found.");
-
-        Customer* c = getCustomer(customerId);
-        if (!c) throw std::invalid_argument("Customer not found.");
-
-        // Check if vehicle is already rented
-        for (const auto* r : rentals) {
-            if (r->getVehicle()->getRegNumber() == regNumber) {
-                throw std::invalid_argument("Vehicle is already rented.");
-            }
+    void uncountReservation(const std::string& customerId) {
+        markDirty(Checkpointer::Section::Reservations);
+        auto* count = reservationsByCustomer.find(customerId);
+        if (!count) return;
+        if (*count == 1) {
+            reservationsByCustomer.erase(customerId);
+        } else {
+            --*count;
         }
+    }
 
-        // Create new rental
-        Rental* rental = new Rental(v, c, startDate, endDate);
-        rentals.push_back(rental);
-        if (showMessage) std::cout << "Vehicle rented successfully.\n";
+    /**
+     * @brief Remove a reservation and stop counting it.
+     */
+    void dropReservation(std::size_t slot, const Booking& b) {
+        std::string customerId = b.customerId; // b is removed first
+        reservations.remove(slot, b.startDay);
+        uncountReservation(customerId);
     }
 
     /**
-     * @brief Return a vehicle (end the rental).
-     * @param regNumber Registration number of the vehicle to return.
-     * @return Total cost of the rental.
-     * @throws std::invalid_argument If vehicle is not currently rented.
+     * @brief Check whether an active rental overlaps [startDay, endDay).
      */
-    double returnVehicle(const std::string& regNumber, double newMileage) {
-        auto it = std::find_if(rentals.begin(), rentals.end(),
-            [&regNumber](Rental* r) {
-                return r->getVehicle()->getRegNumber() == regNumber;
-            });
+    static bool overlaps(const Rental* r, int startDay, int endDay) {
+        return r->getStartDay() < endDay && startDay < r->getEndDay();
+    }
 
-        if (it == rentals.end()) {
-            throw std::invalid_argument("Rental not found for this vehicle.");
+    /**
+     * @brief Read the reservations at the end of a snapshot (version 2 and later).
+     * @throws std::runtime_error If the block is missing.
+     */
+    void readSnapshotReservations(BinaryReader& in) {
+        std::uint32_t count = in.getU32();
+        for (std::uint32_t i = 0; i < count; ++i) {
+            BinaryReader record = in.getRecord();
+            std::string reg(record.getString());
+            std::string customerId(record.getString());
+            std::string start(record.getString());
+            std::string end(record.getString());
+            try {
+                reserveVehicle(reg, customerId, start, end);
+            } catch (const std::invalid_argument&) {}
         }
+    }
 
-        Rental* r = *it;
-        
-        // Update mileage
-        r->getVehicle()->setMileage(newMileage);
-
-        double cost = r->calculateTotalCost();
+    /**
+     * @brief Record a service loaded from the data file (unknown vehicles and tasks are skipped).
+     */
+    void loadService(std::string_view regNumber, std::string_view taskName, double mileage) {
+        auto* slot = vehicleIndex.find(regNumber);
+        MaintenanceSchedule::Task task;
+        if (!slot || !MaintenanceSchedule::parseTask(taskName, task)) return;
+        try {
+            maintenance.setLastService(*slot, task, mileage);
+        } catch (const std::invalid_argument&) {}
+        refreshAvailability(*slot, isRented(regNumber));
+    }
 
-        // Add to history
-        std::stringstream ss;
-        ss << r->getVehicle()->getBrand() << " " << r->getVehicle()->getModel() 
-           << " (" << r->getVehicle()->getRegNumber() << ");"
-           << r->getCustomer()->getName() << " (" << r->getCustomer()->getId() << ");"
-           << r->getStartDate() << ";" << r->getEndDate() << ";" << cost;
-        rentalHistory.push_back(ss.str());
-        delete r;
-        rentals.erase(it);
+    /**
+     * @brief Set the km between two services of a task and refresh which vehicles are due.
+     * @throws std::invalid_argument If the interval is not positive.
+     */
+    void applyServiceInterval(MaintenanceSchedule::Task task, double km) {
+        maintenance.setInterval(task, km);
+        markDirty(Checkpointer::Section::Maintenance);
+        Bitset rented;
+        rented.resize(slots.size());
+        for (const auto* r : rentals) rented.set(slotOf(r->getVehicle()));
+        for (std::size_t slot : vehicleOrder) refreshAvailability(slot, rented.test(slot));
+    }
 
-        return cost;
+    /**
+     * @brief Set a service interval loaded from the data file (invalid intervals are skipped).
+     * @param task Index of a MaintenanceSchedule::Task.
+     */
+    void loadServiceInterval(std::size_t task, double km) {
+        try {
+            applyServiceInterval(static_cast<MaintenanceSchedule::Task>(task), km);
+        } catch (const std::invalid_argument&) {}
     }
 
     /**
-     * @brief Display all active rentals.
+     * @brief Visit the last service of every task of every vehicle, in vehicle order.
+     * @param header Called first as header(number of services).
+     * @param f Called as f(slot, task, mileage at last service).
      */
-    void showInfo() const {
-        if (rentals.empty()) {
-            std::cout << "No active rentals.\n";
-            return;
+    template <typename H, typename F>
+    void forEachService(H&& header, F&& f) const {
+        using Task = MaintenanceSchedule::Task;
+        std::size_t count = 0;
+        for (int k = 0; k < Vehicle::kindCount; ++k) {
+            for (int t = 0; t < MaintenanceSchedule::taskCount; ++t) {
+                if (MaintenanceSchedule::appliesTo(static_cast<Vehicle::VehicleKind>(k), static_cast<Task>(t))) {
+                    count += slotsByKind[k].size();
+                }
+            }
         }
-        for (const auto* r : rentals) {
-            std::cout << r->getInfo() << "\n=================\n";
+        header(count);
+        for (std::size_t slot : vehicleOrder) {
+            auto kind = static_cast<Vehicle::VehicleKind>(columns.getKinds()[slot]);
+            for (int t = 0; t < MaintenanceSchedule::taskCount; ++t) {
+                if (MaintenanceSchedule::appliesTo(kind, static_cast<Task>(t))) {
+                    f(slot, static_cast<Task>(t), maintenance.getLastService(slot, static_cast<Task>(t)));
+                }
+            }
         }
     }
 
-    void showRentalHistory() const {
-        if (rentalHistory.empty()) {
-            std::cout << "No rental history.\n";
-            return;
-        }
-        std::cout << "=== Rental History ===\n";
-        for (const auto& entry : rentalHistory) {
-            std::stringstream ss(entry);
-            std::string segment;
-            std::vector<std::string> parts;
-            while(std::getline(ss, segment, ';')) parts.push_back(segment);
-
-            if (parts.size() >= 5) {
-                std::cout << "Vehicle: " << parts[0] << "\n"
-                          << "Customer: " << parts[1] << "\n"
-                          << "Period: " << parts[2] << " - " << parts[3] << "\n"
-                          << "Cost: " << parts[4] << " zl\n"
-                          << "-----------------\n";
+    /**
+     * @brief Read the service intervals and records at the end of a snapshot.
+     * The intervals are in version 3 and later; version 2 snapshots may lack the whole block.
+     * @throws std::runtime_error If a version 3 snapshot lacks the block.
+     */
+    void readSnapshotMaintenance(BinaryReader& in, std::uint32_t fileVersion) {
+        if (fileVersion < 3 && in.remaining() == 0) return;
+        if (fileVersion >= 3) {
+            std::uint32_t intervalCount = in.getU32();
+            for (std::uint32_t t = 0; t < intervalCount; ++t) {
+                double km = in.getDouble();
+                if (t < MaintenanceSchedule::taskCount) loadServiceInterval(t, km);
             }
         }
+        std::uint32_t count = in.getU32();
+        for (std::uint32_t i = 0; i < count; ++i) {
+            BinaryReader record = in.getRecord();
+            std::string_view reg = record.getString();
+            std::string_view task = record.getString();
+            loadService(reg, task, record.getDouble());
+        }
     }
 
-    // --- Persistence ---
-
     /**
-     * @brief Save global state to file.
-     * @param filename Path to file.
+     * @brief Read the sections of a snapshot that follow the customers.
+     * @throws std::runtime_error If the file is truncated.
      */
-    void saveToFile(const std::string& filename) const {
-        std::ofstream file(filename);
-        if (!file.is_open()) throw std::runtime_error("Could not open file for saving.");
-
-        // Save Vehicles
-        file << vehicles.size() << "\n"; // Number of vehicles
-        for (const auto* v : vehicles) {
-            if (auto* p = dynamic_cast<const CombustionCar*>(v)) {
-                // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Doors
-                file << "CombustionCar;" 
-                     << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
-                     << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
-                     << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
-                     << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
-                     << p->getDoors() << "\n";
-            } else if (auto* p = dynamic_cast<const ElectricCar*>(v)) {
-                // Type;Brand;Model;Reg;Cost;Battery;Licence;Mileage;Doors
-                file << "ElectricCar;" 
-                     << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
-                     << p->getBaseCost() << ";" << p->getBatteryCapacity() << ";" 
-                     << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
-                     << p->getDoors() << "\n";
-            } else if (auto* p = dynamic_cast<const Truck*>(v)) {
-                // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Capacity
-                file << "Truck;" 
-                     << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
-                     << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
-                     << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
-                     << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
-                     << p->getCargoCapacity() << "\n";
-            } else if (auto* p = dynamic_cast<const Motorcycle*>(v)) {
-                // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage
-                file << "Motorcycle;" 
-                     << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
-                     << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
-                     << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
-                     << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << "\n";
-            }
-        }
-
-        // Save Customers
-        file << customers.size() << "\n"; // Number of customers
-        for (const auto* c : customers) {
-            if (auto* p = dynamic_cast<const PrivateCustomer*>(c)) {
-                // PrivateCustomer;Name;Address;IDCard
-                file << "PrivateCustomer;" << p->getName() << ";" 
-                     << p->getAddress() << ";" << p->getIdCardNumber() << "\n";
-            } else if (auto* p = dynamic_cast<const BusinessCustomer*>(c)) {
-                // BusinessCustomer;Name;Address;NIP
-                file << "BusinessCustomer;" << p->getName() << ";" << p->getAddress() << ";" << p->getNip() << "\n";
-            }
-        }
-
-        // Save Rentals
-        file << rentals.size() << "\n"; // Number of rentals
-        for (const auto* r : rentals) {
-            file << r->getVehicle()->getRegNumber() << ";"
-                 << r->getCustomer()->getId() << ";"
-                 << r->getStartDate() << ";"
-                 << r->getEndDate() << "\n";
+    void readSnapshotTail(BinaryReader& in, std::uint32_t fileVersion) {
+        std::uint32_t rCount = in.getU32();
+        for (std::uint32_t i = 0; i < rCount; ++i) {
+            BinaryReader record = in.getRecord();
+            std::string reg(record.getString());
+            std::string customerId(record.getString());
+            std::string start(record.getString());
+            std::string end(record.getString());
+            try {
+                rentVehicle(reg, customerId, start, end, false);
+            } catch (const std::invalid_argument&) {}
         }
 
-        // Save History
-        file << rentalHistory.size() << "\n";
-        for (const auto& entry : rentalHistory) {
-             file << entry << "\n";
+        std::uint32_t hCount = in.getU32();
+        rentalHistory.reserve(std::min<std::size_t>(hCount, in.remaining()));
+        for (std::uint32_t i = 0; i < hCount; ++i) {
+            addHistoryLine(in.getString());
         }
-
-        file.close();
+        if (fileVersion >= 2) readSnapshotReservations(in);
+        readSnapshotMaintenance(in, fileVersion);
     }
 
     /**
-     * @brief Load global state from file.
-     * @param filename Path to file.
+     * @brief Parse a history line of the data file and append it (malformed lines are skipped).
+     * Current vehicles and customers supply the kind and type of lines written without them;
+     * records of a mapped snapshot are read without building their objects.
      */
-    void loadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) return;
-
-        // Clear existing
-        for (auto* r : rentals) delete r; rentals.clear();
-        for (auto* v : vehicles) delete v; vehicles.clear();
-        for (auto* c : customers) delete c; customers.clear();
-
-        std::string line; //buffer for reading lines
-        
-        // Load Vehicles
-        int vCount = 0;
-        if (std::getline(file, line)) vCount = std::stoi(line);
+    void addHistoryLine(std::string_view line) {
+        rentalHistory.addLine(
+            line,
+            [this](std::string_view reg) -> std::optional<RentalHistory::VehicleInfo> {
+                auto* slot = vehicleIndex.find(reg);
+                if (!slot) return std::nullopt;
+                RentalHistory::VehicleInfo info;
+                info.kind = columns.getKinds()[*slot];
+                if (const Vehicle* v = slots[*slot]) {
+                    info.brand = v->getBrand();
+                    info.model = v->getModel();
+                } else {
+                    std::string_view record = vehicleRecords[*slot];
+                    auto summary = Snapshot::readVehicleSummary(BinaryReader(record.data(), record.size()));
+                    info.brand = summary.brand;
+                    info.model = summary.model;
+                }
+                return info;
+            },
+            [this](std::string_view id) -> std::optional<RentalHistory::CustomerInfo> {
+                auto* slot = customerIndex.find(id);
+                if (!slot) return std::nullopt;
+                RentalHistory::CustomerInfo info;
+                if (const Customer* c = customerSlots[*slot]) {
+                    info.name = c->getName();
+                    info.type = static_cast<std::uint8_t>(c->getType());
+                } else {
+                    std::string_view record = customerRecords[*slot];
+                    auto summary = Snapshot::readCustomerSummary(BinaryReader(record.data(), record.size()));
+                    info.name = summary.name;
+                    info.type = static_cast<std::uint8_t>(summary.type);
+                }
+                return info;
+            });
+    }
 
-        for (int i = 0; i < vCount; ++i) {  //cutting line of text into parts
-            if (!std::getline(file, line)) break;
-            std::stringstream ss(line);
-            std::string segment;
-            std::vector<std::string> parts;
-            while (std::getline(ss, segment, ';')) parts.push_back(segment);
+    /**
+     * @brief Move a full history tail into a new history log segment (no-op without a log).
+     * The segment becomes part of the history with the next save.
+     */
+    void sealHistory() {
+        if (!historyLog || rentalHistory.size() < historyLog->getSegmentRecords()) return;
+        historyLog->seal(rentalHistory);
+        rentalHistory.clear();
+        markDirty(Checkpointer::Section::History);
+    }
 
-            if (parts.empty()) continue;
+    /**
+     * @brief Record that a section must be rewritten by the next checkpoint.
+     */
+    void markDirty(Checkpointer::Section section) {
+        dirtySections |= static_cast<std::uint8_t>(1u << static_cast<int>(section));
+    }
 
-            Vehicle* v = nullptr;
-            try {
+    /**
+     * @brief Append an operation to the journal (no-op if journaling is off).
+     * @param writePayload Called as writePayload(BinaryWriter&) to encode the operation's arguments.
+     */
+    template <typename F>
+    void logOperation(Journal::Op op, F&& writePayload) {
+        if (!journal) return;
+        BinaryWriter out;
+        out.putU8(static_cast<std::uint8_t>(op));
+        writePayload(out);
+        journal->append(out.data());
+    }
 
-                if (parts[0] == "CombustionCar" && parts.size() >= 11) {
-                    // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Doors
-                    //   0    1     2    3   4     5      6         7        8       9     10
-                    auto fuel = static_cast<CombustionVehicle::FuelType>(std::stoi(parts[7]));
-                    auto cat = static_cast<Vehicle::LicenceCategory>(std::stoi(parts[8]));
-                    v = new CombustionCar(
-                        parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]), 
-                        cat, std::stoi(parts[5]), std::stod(parts[6]), fuel, std::stoi(parts[10])
-                    );
-                } else if (parts[0] == "ElectricCar" && parts.size() >= 9) {
-                    // Type;Brand;Model;Reg;Cost;Battery;Licence;Mileage;Doors
-                    //   0    1     2     3   4    5       6       7       8
-                    auto cat = static_cast<Vehicle::LicenceCategory>(std::stoi(parts[6]));
-                    v = new ElectricCar(
-                        parts[3], parts[1], parts[2], std::stod(parts[7]), std::stod(parts[4]), 
-                        cat, std::stod(parts[5]), std::stoi(parts[8])
-                    );
-                } else if (parts[0] == "Truck" && parts.size() >= 11) {
-                    // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Capacity
-                    //   0    1     2    3   4    5        6        7        8       9       10
-                    auto fuel = static_cast<CombustionVehicle::FuelType>(std::stoi(parts[7]));
-                    auto cat = static_cast<Vehicle::LicenceCategory>(std::stoi(parts[8]));
-                    v = new Truck(
-                        parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]), 
-                        cat, std::stoi(parts[5]), std::stod(parts[6]), fuel, std::stoi(parts[10])
-                    );
-                } else if (parts[0] == "Motorcycle" && parts.size() >= 10) {
-                     // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage
-                     //   0    1     2    3   4    5        6        7        8       9
-                    auto fuel = static_cast<CombustionVehicle::FuelType>(std::stoi(parts[7]));
-                    auto cat = static_cast<Vehicle::LicenceCategory>(std::stoi(parts[8]));
-                    v = new Motorcycle(
-                        parts[3], parts[1], parts[2], std::stod(parts[9]), std::stod(parts[4]), 
-                        cat, std::stoi(parts[5]), std::stod(parts[6]), fuel
-                    );
+    /**
+     * @brief Re-run one journaled operation.
+     * @throws std::invalid_argument If the operation fails, std::runtime_error if it is malformed.
+     */
+    void applyJournalEntry(Journal::Op op, BinaryReader& in) {
+        switch (op) {
+            case Journal::Op::AddVehicle: {
+                Vehicle* v = Snapshot::readVehicle(in.getRecord());
+                try {
+                    addVehicle(v);
+                } catch (...) {
+                    delete v;
+                    throw;
                 }
-
-                if (v) vehicles.push_back(v);
-            } catch (const std::exception& e) {
-                std::cout << "[Error Loading Vehicle]: " << e.what() << " Line: " << line << "\n";
-                if (v) delete v;
+                break;
+            }
+            case Journal::Op::RemoveVehicle:
+                removeVehicle(std::string(in.getString()));
+                break;
+            case Journal::Op::AddCustomer: {
+                Customer* c = Snapshot::readCustomer(in.getRecord());
+                try {
+                    addCustomer(c);
+                } catch (...) {
+                    delete c;
+                    throw;
+                }
+                break;
+            }
+            case Journal::Op::RemoveCustomer:
+                removeCustomer(std::string(in.getString()));
+                break;
+            case Journal::Op::Rent: {
+                std::string reg(in.getString());
+                std::string customerId(in.getString());
+                std::string start(in.getString());
+                std::string end(in.getString());
+                rentVehicle(reg, customerId, start, end, false);
+                break;
+            }
+            case Journal::Op::Return: {
+                std::string reg(in.getString());
+                double mileage = in.getDouble();
+                returnVehicle(reg, mileage);
+                break;
+            }
+            case Journal::Op::Reserve: {
+                std::string reg(in.getString());
+                std::string customerId(in.getString());
+                std::string start(in.getString());
+                std::string end(in.getString());
+                reserveVehicle(reg, customerId, start, end);
+                break;
+            }
+            case Journal::Op::CancelReservation: {
+                std::string reg(in.getString());
+                std::string start(in.getString());
+                cancelReservation(reg, start);
+                break;
+            }
+            case Journal::Op::Service: {
+                std::string reg(in.getString());
+                auto task = static_cast<MaintenanceSchedule::Task>(in.getU8());
+                if (static_cast<int>(task) >= MaintenanceSchedule::taskCount) {
+                    throw std::runtime_error("Corrupt journal entry.");
+                }
+                serviceVehicle(reg, task);
+                break;
+            }
+            case Journal::Op::ServiceInterval: {
+                auto task = static_cast<MaintenanceSchedule::Task>(in.getU8());
+                if (static_cast<int>(task) >= MaintenanceSchedule::taskCount) {
+                    throw std::runtime_error("Corrupt journal entry.");
+                }
+                setServiceInterval(task, in.getDouble());
+                break;
+            }
+            case Journal::Op::UpdateVehicle: {
+                std::unique_ptr<Vehicle> updated(Snapshot::readVehicle(in.getRecord()));
+                Vehicle* v = getVehicle(updated->getRegNumber());
+                if (!v || v->getKind() != updated->getKind()) throw std::invalid_argument("Vehicle not found.");
+                assignVehicle(*v, *updated);
+                break;
+            }
+            case Journal::Op::SetEndDate: {
+                std::string reg(in.getString());
+                Rental* r = getActiveRental(reg);
+                if (!r) throw std::invalid_argument("Rental not found for this vehicle.");
+                r->setEndDate(std::string(in.getString()));
+                break;
+            }
+            default:
+                throw std::runtime_error("Unknown journal operation.");
+        }
+    }
+
+    /**
+     * @brief Replace a file atomically (see FileIO::writeAtomically).
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void writeFileAtomically(const std::string& filename, const std::string& bytes) {
+        if (!FileIO::writeAtomically(filename, bytes)) throw std::runtime_error("Could not write file.");
+    }
+
+    /**
+     * @brief Re-run the journal entries after a sequence number.
+     * Operations that fail are skipped, like invalid lines when loading.
+     */
+    Journal::ReplayResult replayJournal(const std::string& journalFile, std::uint64_t id,
+                                        std::uint64_t afterSequence) {
+        return Journal::replay(journalFile, id, afterSequence, [&](Journal::Op op, BinaryReader& in) {
+            try {
+                applyJournalEntry(op, in);
+            } catch (const std::exception&) {}
+        });
+    }
+
+    static constexpr std::size_t parallelChunkLines = 16384; // Lines per parser task
+
+    /**
+     * @brief Result of parsing one line of an entity section.
+     */
+    template <typename T>
+    struct ParsedLine {
+        T* object = nullptr; // nullptr if the line is not a record
+        std::string error;   // Validation error, empty on success
+    };
+
+    /**
+     * @brief Parse the lines of a section, in chunks on the pool if one is given.
+     * @param parse Called as parse(line); returns a new object or nullptr, may throw.
+     * @return One result per line, in line order.
+     */
+    template <typename T, typename Parse>
+    static std::vector<ParsedLine<T>> parseSection(const std::vector<std::string_view>& lines,
+                                                   Parse parse, ThreadPool* pool) {
+        std::vector<ParsedLine<T>> results(lines.size());
+        auto parseRange = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                try {
+                    results[i].object = parse(lines[i]);
+                } catch (const std::exception& e) {
+                    results[i].error = e.what();
+                }
+            }
+        };
+
+        if (!pool || lines.size() < 2 * parallelChunkLines) {
+            parseRange(0, lines.size());
+            return results;
+        }
+        std::vector<std::future<void>> chunks;
+        for (std::size_t begin = 0; begin < lines.size(); begin += parallelChunkLines) {
+            std::size_t end = std::min(begin + parallelChunkLines, lines.size());
+            chunks.push_back(pool->submit([&parseRange, begin, end] { parseRange(begin, end); }));
+        }
+        for (auto& chunk : chunks) chunk.get();
+        return results;
+    }
+
+    /**
+     * @brief Parse a vehicle line of the text format.
+     * @return New vehicle, or nullptr if the line is not a complete vehicle record.
+     * @throws std::invalid_argument If a field is invalid.
+     */
+    static Vehicle* parseVehicleLine(std::string_view line) {
+        std::array<std::string_view, 11> parts;
+        std::size_t n = TextReader::split(line, parts);
+        if (n == 0) return nullptr;
+        auto str = [](std::string_view s) { return std::string(s); };
+
+        if (parts[0] == "CombustionCar" && n >= 11) {
+            // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Doors
+            //   0    1     2    3   4     5      6         7        8       9     10
+            auto fuel = static_cast<CombustionVehicle::FuelType>(TextReader::toInt(parts[7]));
+            auto cat = static_cast<Vehicle::LicenceCategory>(TextReader::toInt(parts[8]));
+            return new CombustionCar(
+                str(parts[3]), str(parts[1]), str(parts[2]), TextReader::toDouble(parts[9]),
+                TextReader::toDouble(parts[4]), cat, TextReader::toInt(parts[5]),
+                TextReader::toDouble(parts[6]), fuel, TextReader::toInt(parts[10])
+            );
+        } else if (parts[0] == "ElectricCar" && n >= 9) {
+            // Type;Brand;Model;Reg;Cost;Battery;Licence;Mileage;Doors
+            //   0    1     2     3   4    5       6       7       8
+            auto cat = static_cast<Vehicle::LicenceCategory>(TextReader::toInt(parts[6]));
+            return new ElectricCar(
+                str(parts[3]), str(parts[1]), str(parts[2]), TextReader::toDouble(parts[7]),
+                TextReader::toDouble(parts[4]), cat, TextReader::toDouble(parts[5]),
+                TextReader::toInt(parts[8])
+            );
+        } else if (parts[0] == "Truck" && n >= 11) {
+            // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Capacity
+            //   0    1     2    3   4    5        6        7        8       9       10
+            auto fuel = static_cast<CombustionVehicle::FuelType>(TextReader::toInt(parts[7]));
+            auto cat = static_cast<Vehicle::LicenceCategory>(TextReader::toInt(parts[8]));
+            return new Truck(
+                str(parts[3]), str(parts[1]), str(parts[2]), TextReader::toDouble(parts[9]),
+                TextReader::toDouble(parts[4]), cat, TextReader::toInt(parts[5]),
+                TextReader::toDouble(parts[6]), fuel, TextReader::toInt(parts[10])
+            );
+        } else if (parts[0] == "Motorcycle" && n >= 10) {
+            // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage
+            //   0    1     2    3   4    5        6        7        8       9
+            auto fuel = static_cast<CombustionVehicle::FuelType>(TextReader::toInt(parts[7]));
+            auto cat = static_cast<Vehicle::LicenceCategory>(TextReader::toInt(parts[8]));
+            return new Motorcycle(
+                str(parts[3]), str(parts[1]), str(parts[2]), TextReader::toDouble(parts[9]),
+                TextReader::toDouble(parts[4]), cat, TextReader::toInt(parts[5]),
+                TextReader::toDouble(parts[6]), fuel
+            );
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Parse a customer line of the text format.
+     * @return New customer, or nullptr if the line is not a complete customer record.
+     * @throws std::invalid_argument If a field is invalid.
+     */
+    static Customer* parseCustomerLine(std::string_view line) {
+        std::array<std::string_view, 4> parts;
+        std::size_t n = TextReader::split(line, parts);
+        if (n < 4) return nullptr;
+
+        if (parts[0] == "PrivateCustomer") {
+            // PrivateCustomer;Name;Address;IDCard (IDCard is the ID)
+            return new PrivateCustomer(std::string(parts[1]), std::string(parts[2]), std::string(parts[3]));
+        } else if (parts[0] == "BusinessCustomer") {
+            // BusinessCustomer;Name;Address;NIP (NIP is the ID)
+            return new BusinessCustomer(std::string(parts[1]), std::string(parts[2]), std::string(parts[3]));
+        }
+        return nullptr;
+    }
+
+public:
+    /**
+     * @brief Constructor.
+     */
+    VehicleManager() = default;
+
+    /**
+     * @brief Destructor.
+     */
+    ~VehicleManager() {
+        clearAll();
+    }
+
+    // --- Vehicle Management ---
+
+    /**
+     * @brief Add a new vehicle to the system.
+     * @param v Raw pointer to the vehicle (takes ownership).
+     * @throws std::invalid_argument If vehicle is null or regNumber not unique.
+     */
+    void addVehicle(Vehicle* v) {
+        if (!v) throw std::invalid_argument("Vehicle cannot be null.");
+        if (!isRegNumberUnique(v->getRegNumber())) {
+            throw std::invalid_argument("Vehicle with this registration number already exists.");
+        }
+        allocateSlot(v);
+        logOperation(Journal::Op::AddVehicle, [&](BinaryWriter& out) { Snapshot::writeVehicle(out, *v); });
+    }
+
+    /**
+     * @brief Remove a vehicle by registration number.
+     * Its reservations that have already ended are removed with it.
+     * @throws std::invalid_argument If the vehicle does not exist, is rented or has a
+     *         reservation that has not ended.
+     */
+    void removeVehicle(const std::string& regNumber) {
+        if (isRented(regNumber)) {
+            throw std::invalid_argument("Cannot remove vehicle that is currently rented.");
+        }
+
+        Vehicle* v = getVehicle(regNumber);
+        if (!v) throw std::invalid_argument("Vehicle not found.");
+        std::size_t slot = slotOf(v);
+        const auto& booked = reservations.bookingsOf(slot);
+        // End days are sorted like start days, so the last booking ends last
+        if (!booked.empty() && booked.back().endDay > Date::today()) {
+            throw std::invalid_argument("Cannot remove vehicle that has reservations.");
+        }
+        while (reservations.hasBookings(slot)) dropReservation(slot, reservations.bookingsOf(slot).front());
+
+        releaseSlot(slot);
+        logOperation(Journal::Op::RemoveVehicle, [&](BinaryWriter& out) { out.putString(regNumber); });
+        delete v; // Free memory
+    }
+
+    /**
+     * @brief Find a vehicle by registration number.
+     * @return Raw pointer to vehicle or nullptr if not found.
+     */
+    Vehicle* getVehicle(std::string_view regNumber) const {
+        auto* slot = vehicleIndex.find(regNumber);
+        return slot ? vehicleAt(*slot) : nullptr;
+    }
+
+    /**
+     * @brief Get the vehicle stored in a slot.
+     * @return Raw pointer to vehicle or nullptr if the slot is free or out of range.
+     */
+    Vehicle* getVehicleBySlot(std::size_t slot) const {
+        return slot < slots.size() ? vehicleAt(slot) : nullptr;
+    }
+
+    /**
+     * @brief Find vehicles by brand.
+     * @return Vector of matching vehicles.
+     */
+    std::vector<Vehicle*> findVehiclesByBrand(std::string_view brand) const {
+        auto* sameBrand = brandIndex.find(brand);
+        return sameBrand ? vehiclesAt(*sameBrand) : std::vector<Vehicle*>{};
+    }
+
+    /**
+     * @brief Find vehicles with base price <= maxPrice.
+     */
+    std::vector<Vehicle*> findVehiclesByPrice(double maxPrice) const {
+        return vehiclesAt(columns.selectCostAtMost(maxPrice));
+    }
+
+    /**
+     * @brief Find vehicles with mileage <= maxMileage.
+     */
+    std::vector<Vehicle*> findVehiclesByMileage(double maxMileage) const {
+        return vehiclesAt(columns.selectMileageAtMost(maxMileage));
+    }
+
+    /**
+     * @brief Find vehicles requiring the given licence category.
+     */
+    std::vector<Vehicle*> findVehiclesByLicence(Vehicle::LicenceCategory cat) const {
+        return vehiclesAt(columns.selectLicence(cat));
+    }
+
+    /**
+     * @brief Find vehicles with base price in [minPrice, maxPrice].
+     * @return Vector of vehicles sorted by price (cheapest first).
+     */
+    std::vector<Vehicle*> findVehiclesInPriceRange(double minPrice, double maxPrice) const {
+        std::vector<Vehicle*> matches;
+        priceIndex.forEachInRange(minPrice, maxPrice, [&](std::size_t slot) {
+            matches.push_back(vehicleAt(slot));
+            return true;
+        });
+        return matches;
+    }
+
+    /**
+     * @brief Find the k cheapest available vehicles priced at most maxPrice.
+     *
+     * Available vehicles have their own price index, so this is
+     * O(log n + k) however much of the fleet is rented.
+     * @return Vector of at most k vehicles sorted by price (cheapest first).
+     */
+    std::vector<Vehicle*> findCheapestAvailable(std::size_t k,
+            double maxPrice = std::numeric_limits<double>::infinity()) const {
+        std::vector<Vehicle*> matches;
+        if (k == 0) return matches;
+        availablePrices.forEachInRange(-std::numeric_limits<double>::infinity(), maxPrice, [&](std::size_t slot) {
+            matches.push_back(vehicleAt(slot));
+            return matches.size() < k;
+        });
+        return matches;
+    }
+
+    /**
+     * @brief Find the k most expensive available vehicles priced at most maxPrice.
+     * O(log n + k), like findCheapestAvailable.
+     * @return Vector of at most k vehicles sorted by price (most expensive first).
+     */
+    std::vector<Vehicle*> findMostExpensiveAvailable(std::size_t k,
+            double maxPrice = std::numeric_limits<double>::infinity()) const {
+        std::vector<Vehicle*> matches;
+        if (k == 0) return matches;
+        availablePrices.forEachDescending(maxPrice, [&](std::size_t slot) {
+            matches.push_back(vehicleAt(slot));
+            return matches.size() < k;
+        });
+        return matches;
+    }
+
+    /**
+     * @brief Evaluate a multi-column filter into a selection bitmap over slot IDs.
+     */
+    Bitset selectVehicles(const VehicleFilter& filter) const {
+        Bitset selection = filter.evaluate(columns);
+        if (filter.requiresAvailable()) selection &= availableSlots;
+        return selection;
+    }
+
+    /**
+     * @brief Find vehicles matching every condition of a filter.
+     * @return Vector of matching vehicles in slot order.
+     */
+    std::vector<Vehicle*> findVehicles(const VehicleFilter& filter) const {
+        Bitset selection = selectVehicles(filter);
+        std::vector<Vehicle*> matches;
+        matches.reserve(selection.count());
+        selection.forEachSet([&](std::size_t slot) { matches.push_back(vehicleAt(slot)); });
+        return matches;
+    }
+
+    /**
+     * @brief Count vehicles matching every condition of a filter.
+     */
+    std::size_t countVehicles(const VehicleFilter& filter) const {
+        return selectVehicles(filter).count();
+    }
+
+    /**
+     * @brief Stream the vehicles matching a query to a callback.
+     *
+     * The candidates come from the smallest of: the brand index, the kind
+     * partitions, the availability bitmap or the whole fleet. Every candidate
+     * is then checked against the remaining criteria. The search stops once the
+     * query's limit is reached, so a small limit only costs as much as finding
+     * that many matches.
+     *
+     * @param query Search criteria with offset/limit.
+     * @param callback Called as callback(Vehicle*) for every result.
+     * @return Number of results passed to the callback.
+     */
+    template <typename F>
+    std::size_t forEachVehicle(const VehicleQuery& query, F&& callback) const {
+        const std::size_t offset = query.getOffset();
+        const std::size_t limit = query.getLimit();
+        std::size_t skipped = 0;
+        std::size_t emitted = 0;
+        if (limit == 0) return 0;
+
+        // Returns false once the limit is reached
+        auto visit = [&](std::size_t slot) {
+            if (!query.matchesColumns(columns, slot, availableSlots.test(slot))) return true;
+            Vehicle* v = vehicleAt(slot);
+            if (!query.matchesObject(*v)) return true;
+            if (skipped < offset) {
+                ++skipped;
+                return true;
+            }
+            callback(v);
+            return ++emitted < limit;
+        };
+        auto visitList = [&](const std::vector<std::size_t>& list) {
+            for (std::size_t slot : list) {
+                if (!visit(slot)) return false;
+            }
+            return true;
+        };
+
+        // Pick the most selective candidate source
+        enum class Source { All, Brand, Kinds, Available };
+        Source source = Source::All;
+        std::size_t best = vehicleOrder.size();
+
+        const std::vector<std::size_t>* sameBrand = nullptr;
+        if (query.getBrand()) {
+            sameBrand = brandIndex.find(*query.getBrand());
+            if (!sameBrand) return 0;
+            if (sameBrand->size() < best) {
+                best = sameBrand->size();
+                source = Source::Brand;
+            }
+        }
+
+        const std::uint8_t kindMask = query.getKindMask();
+        if (kindMask != VehicleQuery::allKinds) {
+            std::size_t total = 0;
+            for (int k = 0; k < Vehicle::kindCount; ++k) {
+                if ((kindMask >> k) & 1u) total += slotsByKind[k].size();
+            }
+            if (total < best) {
+                best = total;
+                source = Source::Kinds;
+            }
+        }
+
+        if (query.isAvailableOnly() && availableSlots.count() < best) {
+            source = Source::Available;
+        }
+
+        switch (source) {
+            case Source::Brand:
+                visitList(*sameBrand);
+                break;
+            case Source::Kinds:
+                for (int k = 0; k < Vehicle::kindCount; ++k) {
+                    if (((kindMask >> k) & 1u) && !visitList(slotsByKind[k])) break;
+                }
+                break;
+            case Source::Available:
+                availableSlots.forEachSetWhile(visit);
+                break;
+            case Source::All:
+                for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+                    if (columns.getLive()[slot] && !visit(slot)) break;
+                }
+                break;
+        }
+        return emitted;
+    }
+
+    /**
+     * @brief Collect the vehicles matching a query.
+     * @return Vector of at most query.limit() vehicles.
+     */
+    std::vector<Vehicle*> findVehicles(const VehicleQuery& query) const {
+        std::vector<Vehicle*> matches;
+        forEachVehicle(query, [&](Vehicle* v) { matches.push_back(v); });
+        return matches;
+    }
+
+    /**
+     * @brief Get the columnar copy of the fleet (rows are slot IDs).
+     */
+    const FleetColumns& getColumns() const { return columns; }
+
+    /**
+     * @brief Find vehicles that can be rented now: not rented and not due for service.
+     * @return Vector of available vehicles in slot order.
+     */
+    std::vector<Vehicle*> findAvailableVehicles() const {
+        std::vector<Vehicle*> available;
+        available.reserve(availableSlots.count());
+        availableSlots.forEachSet([&](std::size_t slot) { available.push_back(vehicleAt(slot)); });
+        return available;
+    }
+
+    /**
+     * @brief Count vehicles that can be rented now (see findAvailableVehicles).
+     */
+    std::size_t countAvailableVehicles() const {
+        return availableSlots.count();
+    }
+
+    /**
+     * @brief Display all vehicles.
+     */
+    void showAllVehicles() const {
+        if (vehicleOrder.empty()) {
+            std::cout << "No vehicles in the system.\n";
+            return;
+        }
+        for (std::size_t slot : vehicleOrder) {
+            std::cout << *vehicleAt(slot) << "\n-----------------\n";
+        }
+    }
+
+    void showCars() const {
+        bool found = showVehiclesOfKind(Vehicle::VehicleKind::CombustionCar);
+        found = showVehiclesOfKind(Vehicle::VehicleKind::ElectricCar) || found;
+        if (!found) std::cout << "No cars found.\n";
+    }
+
+    void showCombustionCars() const {
+        if (!showVehiclesOfKind(Vehicle::VehicleKind::CombustionCar)) std::cout << "No combustion cars found.\n";
+    }
+
+    void showElectricCars() const {
+        if (!showVehiclesOfKind(Vehicle::VehicleKind::ElectricCar)) std::cout << "No electric cars found.\n";
+    }
+
+    void showMotorcycles() const {
+        if (!showVehiclesOfKind(Vehicle::VehicleKind::Motorcycle)) std::cout << "No motorcycles found.\n";
+    }
+
+    void showTrucks() const {
+        if (!showVehiclesOfKind(Vehicle::VehicleKind::Truck)) std::cout << "No trucks found.\n";
+    }
+
+    // --- Customer Management ---
+
+    /**
+     * @brief Add a new customer to the system.
+     * @param c Raw pointer to the customer.
+     * @throws std::invalid_argument If customer is null or ID not unique.
+     */
+    void addCustomer(Customer* c) {
+        if (!c) throw std::invalid_argument("Customer cannot be null.");
+        if (!isCustomerIdUnique(c->getId())) {
+            throw std::invalid_argument("Customer with this ID already exists.");
+        }
+        std::size_t slot = reserveCustomerSlot();
+        customerSlots[slot] = c;
+        indexCustomerSlot(slot, c->getId(), c->getType());
+        logOperation(Journal::Op::AddCustomer, [&](BinaryWriter& out) { Snapshot::writeCustomer(out, *c); });
+    }
+
+    /**
+     * @brief Remove a customer by ID.
+     * Their reservations that have already ended are removed with them.
+     * @throws std::invalid_argument If the customer does not exist, has active rentals or
+     *         has a reservation that has not ended.
+     */
+    void removeCustomer(const std::string& id) {
+        if (hasActiveRentals(id)) {
+            throw std::invalid_argument("Cannot remove customer who has active rentals.");
+        }
+        if (reservationsByCustomer.contains(id)) {
+            int today = Date::today();
+            std::vector<std::pair<std::size_t, Booking>> ended;
+            bool current = false;
+            reservations.forEach([&](std::size_t slot, const Booking& b) {
+                if (b.customerId != id) return;
+                if (b.endDay > today) current = true;
+                ended.emplace_back(slot, b);
+            });
+            if (current) throw std::invalid_argument("Cannot remove customer who has reservations.");
+            for (const auto& [slot, b] : ended) dropReservation(slot, b);
+        }
+
+        Customer* c = getCustomer(id);
+        if (!c) throw std::invalid_argument("Customer not found.");
+
+        std::size_t slot = *customerIndex.find(id);
+        customerOrder.erase(std::find(customerOrder.begin(), customerOrder.end(), slot));
+        auto& part = customersByType[static_cast<int>(c->getType())];
+        part.erase(std::find(part.begin(), part.end(), slot));
+        customerIndex.erase(id);
+        customerSlots[slot] = nullptr;
+        customerRecords[slot] = {};
+        markDirty(Checkpointer::Section::Customers);
+        freeCustomerSlots.push_back(slot);
+        logOperation(Journal::Op::RemoveCustomer, [&](BinaryWriter& out) { out.putString(id); });
+        delete c; // Free memory
+    }
+
+    /**
+     * @brief Find a customer by ID.
+     * @return Raw pointer to customer or nullptr if not found.
+     */
+    Customer* getCustomer(std::string_view id) const {
+        auto* found = customerIndex.find(id);
+        return found ? customerAt(*found) : nullptr;
+    }
+
+    /**
+     * @brief Display all customers.
+     */
+    void showAllCustomers() const {
+        if (customerOrder.empty()) {
+            std::cout << "No customers in the system.\n";
+            return;
+        }
+        for (std::size_t slot : customerOrder) {
+            std::cout << *customerAt(slot) << "\n-----------------\n";
+        }
+    }
+
+    void showPrivateCustomers() const {
+        if (!showCustomersOfType(CustomerType::Private)) std::cout << "No private customers found.\n";
+    }
+
+    void showBusinessCustomers() const {
+        if (!showCustomersOfType(CustomerType::Business)) std::cout << "No business customers found.\n";
+    }
+
+    // --- Rental Management ---
+
+    /**
+     * @brief Create a rental transaction.
+     * @param regNumber Registration number of the vehicle.
+     * @param customerId ID of the customer.
+     * @param startDate Start date (YYYY-MM-DD).
+     * @param endDate End date (YYYY-MM-DD).
+     * @param showMessage If true, prints success message.
+     * @throws std::invalid_argument If vehicle/customer invalid or vehicle already rented.
+     */
+    void rentVehicle(const std::string& regNumber, const std::string& customerId, 
+                     const std::string& startDate, const std::string& endDate, 
+                     bool showMessage = true) {
+        Vehicle* v = getVehicle(regNumber);
+        if (!v) throw std::invalid_argument("Vehicle not found.");
+
+        Customer* c = getCustomer(customerId);
+        if (!c) throw std::invalid_argument("Customer not found.");
+
+        // Check if vehicle is already rented
+        if (isRented(regNumber)) {
+            throw std::invalid_argument("Vehicle is already rented.");
+        }
+        if (maintenance.isDue(slotOf(v))) {
+            throw std::invalid_argument("Vehicle is due for service.");
+        }
+
+        // Create new rental
+        Rental* rental = new Rental(v, c, startDate, endDate);
+        std::size_t slot = slotOf(v);
+        const Booking* booking = reservations.findOverlap(slot, rental->getStartDay(), rental->getEndDay());
+        if (booking) {
+            // Picking up the customer's own reservation turns it into the rental
+            Booking reserved = *booking;
+            bool pickUp = reserved.customerId == customerId && reserved.startDay == rental->getStartDay();
+            if (pickUp) reservations.remove(slot, reserved.startDay);
+            if (!pickUp || reservations.findOverlap(slot, rental->getStartDay(), rental->getEndDay())) {
+                if (pickUp) reservations.add(slot, std::move(reserved));
+                delete rental;
+                throw std::invalid_argument("Vehicle is reserved for this period.");
+            }
+            uncountReservation(customerId);
+        }
+        linkRental(rental);
+        logOperation(Journal::Op::Rent, [&](BinaryWriter& out) {
+            out.putString(regNumber);
+            out.putString(customerId);
+            out.putString(startDate);
+            out.putString(endDate);
+        });
+        if (showMessage) std::cout << "Vehicle rented successfully.\n";
+    }
+
+    /**
+     * @brief Return a vehicle (end the rental).
+     * @param regNumber Registration number of the vehicle to return.
+     * @return Total cost of the rental.
+     * @throws std::invalid_argument If vehicle is not currently rented.
+     */
+    double returnVehicle(const std::string& regNumber, double newMileage) {
+        Rental* r = getActiveRental(regNumber);
+        if (!r) {
+            throw std::invalid_argument("Rental not found for this vehicle.");
+        }
+        
+        // Update mileage (journaled with the return)
+        inOperation = true;
+        try {
+            r->getVehicle()->setMileage(newMileage);
+        } catch (...) {
+            inOperation = false;
+            throw;
+        }
+        inOperation = false;
+
+        double cost = r->calculateTotalCost();
+
+        // Add to history
+        HistoryRecord record;
+        record.vehicle = rentalHistory.internVehicle(*r->getVehicle());
+        record.customer = rentalHistory.internCustomer(*r->getCustomer());
+        record.startDay = r->getStartDay();
+        record.endDay = r->getEndDay();
+        record.costGrosze = std::llround(cost * 100.0);
+        rentalHistory.add(record);
+        if (rentalStatsValid) rentalStats.add(rentalHistory, record);
+        markDirty(Checkpointer::Section::History);
+        logOperation(Journal::Op::Return, [&](BinaryWriter& out) {
+            out.putString(regNumber);
+            out.putDouble(newMileage);
+        });
+        unlinkRental(r);
+        delete r;
+
+        // Seal a full tail now; the segment becomes part of the saved state with the next checkpoint
+        if (checkpointer) {
+            try {
+                sealHistory();
+            } catch (const std::runtime_error&) {} // The return stands; the next checkpoint retries
+        }
+        return cost;
+    }
+
+    /**
+     * @brief Find the active rental of a vehicle.
+     * @return Raw pointer to rental or nullptr if the vehicle is not rented.
+     */
+    Rental* getActiveRental(std::string_view regNumber) const {
+        auto* pos = rentalByVehicle.find(regNumber);
+        return pos ? rentals[*pos] : nullptr;
+    }
+
+    /**
+     * @brief Check if a vehicle is currently rented.
+     */
+    bool isRented(std::string_view regNumber) const {
+        return rentalByVehicle.contains(regNumber);
+    }
+
+    /**
+     * @brief Check if a customer currently rents any vehicle.
+     */
+    bool hasActiveRentals(std::string_view customerId) const {
+        return rentalsByCustomer.contains(customerId);
+    }
+
+    /**
+     * @brief Get active rentals of a customer.
+     * @return Vector of rentals (empty if none).
+     */
+    std::vector<Rental*> getCustomerRentals(std::string_view customerId) const {
+        auto* list = rentalsByCustomer.find(customerId);
+        return list ? *list : std::vector<Rental*>{};
+    }
+
+    /**
+     * @brief Find the active rentals that should have ended before a date.
+     *
+     * Active rentals are kept in a min-heap on end day, so only the overdue
+     * ones are visited: O(k log k) for k results.
+     * @return Rentals ordered by end date, earliest first.
+     * @throws std::invalid_argument If the date is invalid.
+     */
+    std::vector<Rental*> findOverdueRentals(std::string_view date) const {
+        return rentalsEndingBefore(Date::toDayNumber(date), std::numeric_limits<int>::min());
+    }
+
+    /**
+     * @brief Find the active rentals ending on a date or within the following days.
+     *
+     * Walks the rentals heap like findOverdueRentals; rentals already overdue
+     * on the date are visited but not returned.
+     * @param days Number of days after the date still included (0 = ending on the date).
+     * @return Rentals ordered by end date, earliest first.
+     * @throws std::invalid_argument If the date is invalid or days is negative.
+     */
+    std::vector<Rental*> findRentalsDueWithin(std::string_view date, int days) const {
+        if (days < 0) throw std::invalid_argument("Number of days cannot be negative.");
+        int day = Date::toDayNumber(date);
+        long long limit = static_cast<long long>(day) + days + 1;
+        return rentalsEndingBefore(static_cast<int>(std::min<long long>(limit, std::numeric_limits<int>::max())), day);
+    }
+
+    // --- Reservations ---
+
+    /**
+     * @brief Book a vehicle for a future period.
+     *
+     * The period is [startDate, endDate): the vehicle is handed back on the
+     * end date, so a booking may start on the day another one ends. Renting
+     * the vehicle to the same customer from the same start date later picks
+     * the reservation up.
+     * @throws std::invalid_argument If the vehicle or customer does not exist, the dates are
+     *         invalid, or the period overlaps another reservation or the active rental.
+     */
+    void reserveVehicle(const std::string& regNumber, const std::string& customerId,
+                        const std::string& startDate, const std::string& endDate) {
+        Vehicle* v = getVehicle(regNumber);
+        if (!v) throw std::invalid_argument("Vehicle not found.");
+        if (!getCustomer(customerId)) throw std::invalid_argument("Customer not found.");
+
+        Booking booking;
+        if (!Date::parse(startDate, booking.startDay)) {
+            throw std::invalid_argument("Start date must be in format YYYY-MM-DD.");
+        }
+        if (!Date::parse(endDate, booking.endDay)) {
+            throw std::invalid_argument("End date must be in format YYYY-MM-DD.");
+        }
+        if (booking.endDay <= booking.startDay) {
+            throw std::invalid_argument("End date must be later than start date.");
+        }
+        Rental* active = getActiveRental(regNumber);
+        if (active && overlaps(active, booking.startDay, booking.endDay)) {
+            throw std::invalid_argument("Vehicle is rented during this period.");
+        }
+        booking.customerId = customerId;
+        if (!reservations.add(slotOf(v), std::move(booking))) {
+            throw std::invalid_argument("Vehicle is already reserved during this period.");
+        }
+        countReservation(customerId);
+        logOperation(Journal::Op::Reserve, [&](BinaryWriter& out) {
+            out.putString(regNumber);
+            out.putString(customerId);
+            out.putString(startDate);
+            out.putString(endDate);
+        });
+    }
+
+    /**
+     * @brief Cancel the reservation of a vehicle that starts on a date.
+     * @throws std::invalid_argument If there is no such reservation.
+     */
+    void cancelReservation(const std::string& regNumber, const std::string& startDate) {
+        auto* slot = vehicleIndex.find(regNumber);
+        int startDay = 0;
+        if (!slot || !Date::parse(startDate, startDay)) throw std::invalid_argument("Reservation not found.");
+        const auto& list = reservations.bookingsOf(*slot);
+        auto it = std::find_if(list.begin(), list.end(), [&](const Booking& b) { return b.startDay == startDay; });
+        if (it == list.end()) throw std::invalid_argument("Reservation not found.");
+        dropReservation(*slot, *it);
+        logOperation(Journal::Op::CancelReservation, [&](BinaryWriter& out) {
+            out.putString(regNumber);
+            out.putString(startDate);
+        });
+    }
+
+    /**
+     * @brief Get the reservations of a vehicle, sorted by start date.
+     */
+    std::vector<Booking> getReservations(std::string_view regNumber) const {
+        auto* slot = vehicleIndex.find(regNumber);
+        return slot ? reservations.bookingsOf(*slot) : std::vector<Booking>{};
+    }
+
+    /**
+     * @brief Check whether a vehicle is neither reserved nor rented at any time in [startDate, endDate).
+     * @throws std::invalid_argument If a date is invalid.
+     */
+    bool isFreeDuring(std::string_view regNumber, std::string_view startDate, std::string_view endDate) const {
+        int startDay = Date::toDayNumber(startDate), endDay = Date::toDayNumber(endDate);
+        auto* slot = vehicleIndex.find(regNumber);
+        if (!slot) return false;
+        Rental* active = getActiveRental(regNumber);
+        return !(active && overlaps(active, startDay, endDay)) && !reservations.findOverlap(*slot, startDay, endDay);
+    }
+
+    /**
+     * @brief Find the vehicles that are free for the whole period [startDate, endDate).
+     *
+     * Starts from the vehicles that are not rented, adds rented vehicles whose
+     * rental does not overlap the period, then drops those with an overlapping
+     * reservation. Only vehicles that have reservations are searched, each
+     * with a binary search. Vehicles due for service are left out, as they
+     * cannot be rented until serviced.
+     * @return Vector of vehicles in slot order.
+     * @throws std::invalid_argument If a date is invalid.
+     */
+    std::vector<Vehicle*> findVehiclesFreeDuring(std::string_view startDate, std::string_view endDate) const {
+        int startDay = Date::toDayNumber(startDate), endDay = Date::toDayNumber(endDate);
+        Bitset free = availableSlots;
+        for (const auto* r : rentals) {
+            if (!overlaps(r, startDay, endDay)) free.set(slotOf(r->getVehicle()));
+        }
+        reservations.removeBooked(free, startDay, endDay);
+        removeDueForService(free);
+
+        std::vector<Vehicle*> matches;
+        matches.reserve(free.count());
+        free.forEachSet([&](std::size_t slot) { matches.push_back(vehicleAt(slot)); });
+        return matches;
+    }
+
+    /**
+     * @brief Answer many free-for-a-period queries in one pass.
+     *
+     * Active rentals and reservations are collected once as busy periods and
+     * swept together with the queries sorted by end date (see
+     * AvailabilitySweep). Kind and licence restrictions are evaluated once
+     * per distinct combination on the fleet columns. A vehicle is free like
+     * in findVehiclesFreeDuring.
+     * @return One bitmap of slot IDs per query, in query order (see getVehicleBySlot).
+     */
+    std::vector<Bitset> findVehiclesFreeDuring(const std::vector<WindowQuery>& queries) const {
+        std::vector<AvailabilitySweep::Period> busy;
+        busy.reserve(rentals.size() + reservations.size());
+        for (const auto* r : rentals) busy.push_back({r->getStartDay(), r->getEndDay(), slotOf(r->getVehicle())});
+        reservations.forEach([&](std::size_t slot, const Booking& b) { busy.push_back({b.startDay, b.endDay, slot}); });
+
+        std::map<std::pair<int, int>, Bitset> candidates; // (kind, licence), -1 = any
+        return AvailabilitySweep::run(busy, queries, [&](const WindowQuery& q) -> const Bitset& {
+            std::pair<int, int> key(q.kind ? static_cast<int>(*q.kind) : -1,
+                                    q.licence ? static_cast<int>(*q.licence) : -1);
+            auto it = candidates.find(key);
+            if (it == candidates.end()) {
+                VehicleFilter filter;
+                if (q.kind) filter.kind(*q.kind);
+                if (q.licence) filter.licence(*q.licence);
+                it = candidates.emplace(key, filter.evaluate(columns)).first;
+                removeDueForService(it->second);
+            }
+            return it->second;
+        });
+    }
+
+    /**
+     * @brief Quote the rental cost of many vehicles for one or more durations.
+     *
+     * Costs come from the fleet columns, one vectorizable loop per duration
+     * (see FleetColumns::rentCosts), instead of a virtual calculateRentCost()
+     * call per vehicle, and are identical to it.
+     * @param days Durations to quote.
+     * @param selection Slot IDs to quote (e.g. a VehicleFilter result); nullptr for the whole fleet.
+     * @return For each duration in order, (slot ID, cost) pairs of the quoted vehicles by slot ID
+     *         (free slots are skipped).
+     * @throws std::invalid_argument If a duration is not positive and a quoted vehicle rejects it
+     *         (combustion cars and motorcycles; electric cars and trucks cost 0).
+     */
+    std::vector<std::vector<std::pair<std::size_t, double>>> quoteRentCosts(const std::vector<int>& days,
+                                                                           const Bitset* selection = nullptr) const {
+        if (std::any_of(days.begin(), days.end(), [](int d) { return d <= 0; })) {
+            auto rejects = [](std::uint8_t kind) {
+                return kind == static_cast<std::uint8_t>(Vehicle::VehicleKind::CombustionCar) ||
+                       kind == static_cast<std::uint8_t>(Vehicle::VehicleKind::Motorcycle);
+            };
+            bool rejected = false;
+            if (selection) {
+                selection->forEachSet([&](std::size_t slot) {
+                    rejected |= slot < columns.size() && columns.getLive()[slot] && rejects(columns.getKinds()[slot]);
+                });
+            } else {
+                rejected = !slotsByKind[static_cast<int>(Vehicle::VehicleKind::CombustionCar)].empty() ||
+                           !slotsByKind[static_cast<int>(Vehicle::VehicleKind::Motorcycle)].empty();
             }
+            if (rejected) throw std::invalid_argument("Rental duration must be positive.");
         }
 
-        // Load Customers
-        int cCount = 0;
-        if (std::getline(file, line)) cCount = std::stoi(line);
+        std::vector<std::size_t> quoted;
+        if (selection) {
+            selection->forEachSet([&](std::size_t slot) {
+                if (slot < columns.size() && columns.getLive()[slot]) quoted.push_back(slot);
+            });
+        } else {
+            for (std::size_t slot = 0; slot < columns.size(); ++slot) {
+                if (columns.getLive()[slot]) quoted.push_back(slot);
+            }
+        }
+
+        std::vector<std::vector<std::pair<std::size_t, double>>> result;
+        result.reserve(days.size());
+        std::vector<double> costs(columns.size(), 0.0);
+        for (int d : days) {
+            if (d > 0) columns.rentCosts(d, costs.data());
+            else std::fill(costs.begin(), costs.end(), 0.0);
+            std::vector<std::pair<std::size_t, double>> quotes;
+            quotes.reserve(quoted.size());
+            for (std::size_t slot : quoted) quotes.emplace_back(slot, costs[slot]);
+            result.push_back(std::move(quotes));
+        }
+        return result;
+    }
 
-        for (int i = 0; i < cCount; ++i) {
-            if (!std::getline(file, line)) break;
-            std::stringstream ss(line);
-            std::string segment;
-            std::vector<std::string> parts;
-            while (std::getline(ss, segment, ';')) parts.push_back(segment);
+    // --- Maintenance ---
 
-            if (parts.empty()) continue;
+    /**
+     * @brief Record that a service was done at the vehicle's current mileage.
+     * @throws std::invalid_argument If the vehicle is not found or the service does not apply to its type.
+     */
+    void serviceVehicle(const std::string& regNumber, MaintenanceSchedule::Task task) {
+        auto* slot = vehicleIndex.find(regNumber);
+        if (!slot) throw std::invalid_argument("Vehicle not found.");
+        maintenance.service(*slot, task);
+        refreshAvailability(*slot, isRented(regNumber));
+        markDirty(Checkpointer::Section::Maintenance);
+        logOperation(Journal::Op::Service, [&](BinaryWriter& out) {
+            out.putString(regNumber);
+            out.putU8(static_cast<std::uint8_t>(task));
+        });
+    }
 
-            Customer* c = nullptr;
-            try {
-                if (parts[0] == "PrivateCustomer") {
+    /**
+     * @brief Check whether a vehicle is due for service (and cannot be rented).
+     */
+    bool isDueForService(std::string_view regNumber) const {
+        auto* slot = vehicleIndex.find(regNumber);
+        return slot && maintenance.isDue(*slot);
+    }
+
+    /**
+     * @brief Km until a vehicle's next service (zero or negative if it is due).
+     * @throws std::invalid_argument If the vehicle is not found.
+     */
+    double getKmToService(std::string_view regNumber) const {
+        auto* slot = vehicleIndex.find(regNumber);
+        if (!slot) throw std::invalid_argument("Vehicle not found.");
+        return maintenance.kmToService(*slot);
+    }
+
+    /**
+     * @brief Mileage at which a service was last done (the mileage the vehicle was added with if never).
+     * @throws std::invalid_argument If the vehicle is not found or the service does not apply to its type.
+     */
+    double getLastService(std::string_view regNumber, MaintenanceSchedule::Task task) const {
+        auto* slot = vehicleIndex.find(regNumber);
+        if (!slot) throw std::invalid_argument("Vehicle not found.");
+        return maintenance.getLastService(*slot, task);
+    }
+
+    /**
+     * @brief Find the vehicles due for service, or due within a distance.
+     *
+     * Vehicles are ordered by km to their next service, so only the
+     * returned vehicles are visited.
+     * @param withinKm 0 for the vehicles that are due now.
+     * @return Vector of vehicles, most overdue first.
+     */
+    std::vector<Vehicle*> findVehiclesDueForService(double withinKm = 0.0) const {
+        std::vector<Vehicle*> result;
+        maintenance.forEachDueWithin(withinKm, [&](std::size_t slot, double) { result.push_back(vehicleAt(slot)); });
+        return result;
+    }
+
+    /**
+     * @brief Set the km between two services of a kind (applies to every vehicle).
+     * @throws std::invalid_argument If the interval is not positive.
+     */
+    void setServiceInterval(MaintenanceSchedule::Task task, double km) {
+        applyServiceInterval(task, km);
+        logOperation(Journal::Op::ServiceInterval, [&](BinaryWriter& out) {
+            out.putU8(static_cast<std::uint8_t>(task));
+            out.putDouble(km);
+        });
+    }
+
+    /**
+     * @brief Display all active rentals.
+     */
+    void showInfo() const {
+        if (rentals.empty()) {
+            std::cout << "No active rentals.\n";
+            return;
+        }
+        for (const auto* r : rentals) {
+            std::cout << r->getInfo() << "\n=================\n";
+        }
+    }
+
+    /**
+     * @brief Get the completed rentals kept in memory (the tail not yet sealed if the history log is open).
+     */
+    const RentalHistory& getRentalHistory() const { return rentalHistory; }
+
+    /**
+     * @brief Number of completed rentals, sealed and in memory.
+     */
+    std::uint64_t getHistorySize() const {
+        return (historyLog ? historyLog->size() : 0) + rentalHistory.size();
+    }
+
+    /**
+     * @brief Call f(part, record) for every completed rental, oldest first.
+     * Sealed segments are read one at a time, so memory stays bounded by one segment.
+     * @param part History holding the record (resolves its vehicle and customer).
+     * @throws std::runtime_error If a history segment is missing or corrupt.
+     */
+    template <typename F>
+    void forEachHistoryRecord(F&& f) const {
+        if (historyLog) historyLog->forEach(f);
+        for (const auto& record : rentalHistory.getRecords()) f(rentalHistory, record);
+    }
+
+    /**
+     * @brief Get revenue and utilization rollups of the whole history.
+     * Built from the history on first use (see rebuildRentalStats), then kept up to date by returnVehicle.
+     */
+    const RentalStats& getRentalStats() const {
+        if (!rentalStatsValid) rebuildRentalStats();
+        return rentalStats;
+    }
+
+    /**
+     * @brief Rebuild the rollups from the history.
+     * Every sealed segment and every chunk of the in-memory tail is
+     * aggregated as a separate task, and the results are merged in history order.
+     * @param threads Number of threads (0 = one per hardware thread).
+     * @throws std::runtime_error If a history segment is missing or corrupt.
+     */
+    void rebuildRentalStats(std::size_t threads = 0) const {
+        const std::size_t segmentCount = historyLog ? historyLog->getSegments().size() : 0;
+        const auto& tail = rentalHistory.getRecords();
+        const std::size_t parts = segmentCount + (tail.size() + parallelChunkLines - 1) / parallelChunkLines;
+        auto buildPart = [&](std::size_t part) {
+            RentalStats stats;
+            if (part < segmentCount) {
+                RentalHistory segment;
+                historyLog->readSegment(historyLog->getSegments()[part], segment);
+                for (const auto& record : segment.getRecords()) stats.add(segment, record);
+            } else {
+                std::size_t begin = (part - segmentCount) * parallelChunkLines;
+                std::size_t end = std::min(begin + parallelChunkLines, tail.size());
+                for (std::size_t i = begin; i < end; ++i) stats.add(rentalHistory, tail[i]);
+            }
+            return stats;
+        };
+
+        rentalStatsValid = false;
+        rentalStats.clear();
+        if (threads == 0) threads = ThreadPool::defaultThreadCount();
+        if (parts < 2 || threads < 2) {
+            for (std::size_t part = 0; part < parts; ++part) rentalStats.merge(buildPart(part));
+        } else {
+            ThreadPool pool(std::min(threads, parts));
+            std::vector<std::future<RentalStats>> results;
+            for (std::size_t part = 0; part < parts; ++part) {
+                results.push_back(pool.submit([&buildPart, part] { return buildPart(part); }));
+            }
+            for (auto& result : results) rentalStats.merge(result.get());
+        }
+        rentalStatsValid = true;
+    }
+
+    /**
+     * @brief Fleet utilization in a month: rented days divided by the current fleet size times the days of the month.
+     */
+    double getFleetUtilization(int year, int month) const {
+        return getRentalStats().utilization(year, month, vehicleOrder.size());
+    }
+
+    void showRentalHistory() const {
+        if (getHistorySize() == 0) {
+            std::cout << "No rental history.\n";
+            return;
+        }
+        std::cout << "=== Rental History ===\n";
+        forEachHistoryRecord([](const RentalHistory& part, const HistoryRecord& record) {
+            std::cout << "Vehicle: " << part.vehicleOf(record).label << "\n"
+                      << "Customer: " << part.customerOf(record).label << "\n"
+                      << "Period: " << Date::toString(record.startDay) << " - " << Date::toString(record.endDay) << "\n"
+                      << "Cost: " << record.getCost() << " zl\n"
+                      << "-----------------\n";
+        });
+    }
+
+    // --- Persistence ---
+
+    /**
+     * @brief Save global state to file.
+     * The file is replaced atomically.
+     * @param filename Path to file.
+     */
+    void saveToFile(const std::string& filename) const {
+        writeFileAtomically(filename, renderText());
+    }
+
+    /**
+     * @brief Save global state to file and start a new, empty journal on it.
+     * @param filename Path to file.
+     */
+    void checkpoint(const std::string& filename) {
+        sealHistory();
+        std::string text = renderText();
+        writeFileAtomically(filename, text);
+        if (journal && !checkpointer) journal->reset(Journal::hashOf(text));
+    }
+
+    /**
+     * @brief Keep completed rentals in append-only segment files, with only the tail in memory.
+     *
+     * Call before loading state. The tail is sealed into a new segment by
+     * checkpoint() and checkpointAsync() once it holds segmentRecords records;
+     * with checkpointing enabled, a return that fills the tail seals it at
+     * once, but only the next checkpoint references the new segment, so
+     * discardJournal() still drops it. Saved state then lists the segments
+     * instead of their records (snapshots still contain every record).
+     * @param baseFile Path prefix of the segment files.
+     * @param segmentRecords Records per segment.
+     */
+    void openHistoryLog(const std::string& baseFile,
+                        std::size_t segmentRecords = HistoryLog::defaultSegmentRecords) {
+        historyLog = std::make_unique<HistoryLog>(baseFile, segmentRecords);
+    }
+
+    /**
+     * @brief Replay the journal of a data file and keep journaling every mutating operation.
+     *
+     * Call after loading the data file. Entries are replayed only if the
+     * journal was started on the current contents of the data file; a journal
+     * older than the last save is discarded. Operations that fail on replay
+     * are skipped, like invalid lines when loading.
+     * @param journalFile Path to the journal.
+     * @param dataFile Path to the data file the journal applies to.
+     * @throws std::runtime_error If the journal cannot be opened.
+     */
+    void openJournal(const std::string& journalFile, const std::string& dataFile) {
+        checkpointer.reset();
+        journal.reset();
+        std::uint64_t baseHash = Journal::hashOfFile(dataFile);
+        auto replayed = replayJournal(journalFile, baseHash, 0);
+        if (historyLog) historyLog->removeUnreferenced();
+        journal = std::make_unique<Journal>(journalFile, baseHash, replayed);
+    }
+
+    /**
+     * @brief Load the last checkpoint, replay the journal after it and keep journaling.
+     *
+     * Without a checkpoint manifest the state is seeded from a text data file
+     * and a new journal is started; a generation 0 manifest records its ID at
+     * once, so the journal of a session that crashes before its first
+     * checkpoint is replayed on the seed file. Checkpoints are then taken
+     * with checkpointAsync().
+     * @param manifestFile Path to the checkpoint manifest.
+     * @param journalFile Path to the journal.
+     * @param seedFile Text data file used when there is no checkpoint yet.
+     * @throws std::runtime_error If the checkpoint is corrupt or the journal cannot be opened.
+     */
+    void openCheckpoint(const std::string& manifestFile, const std::string& journalFile,
+                        const std::string& seedFile) {
+        Checkpointer::Manifest manifest;
+        bool found = Checkpointer::readManifest(manifestFile, manifest);
+        if (found && manifest.generation > 0) {
+            loadFromText(Checkpointer::readSegments(manifestFile, manifest));
+            dirtySections = 0;
+        } else {
+            clearAll();
+            loadFromFile(seedFile);
+            if (!found) {
+                std::random_device rd;
+                manifest.journalId = (static_cast<std::uint64_t>(rd()) << 32) ^ rd() ^
+                    static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+                // Without the ID on disk, a crash before the first checkpoint would orphan the journal
+                Checkpointer::writeManifest(manifestFile, manifest);
+            }
+        }
+        auto replayed = replayJournal(journalFile, manifest.journalId, manifest.lastSequence);
+        if (historyLog) historyLog->removeUnreferenced(); // Segments of unsaved or replaced state
+        journal = std::make_unique<Journal>(journalFile, manifest.journalId, replayed);
+        checkpointer = std::make_unique<Checkpointer>(manifestFile, manifest, journal.get());
+    }
+
+    /**
+     * @brief Start a checkpoint of the sections changed since the last one and return immediately.
+     *
+     * The changed sections are rendered to text on the calling thread (an
+     * in-memory copy, no I/O); writing, syncing and renaming the files runs
+     * on the checkpointer's thread.
+     * @throws std::runtime_error If checkpointing was not enabled with openCheckpoint().
+     */
+    void checkpointAsync() {
+        if (!checkpointer) throw std::runtime_error("Checkpointing is not enabled.");
+        sealHistory();
+        Checkpointer::SectionTexts texts;
+        for (int s = 0; s < Checkpointer::sectionCount; ++s) {
+            if (!((dirtySections >> s) & 1u)) continue;
+            std::ostringstream out;
+            renderSection(static_cast<Checkpointer::Section>(s), out);
+            texts[s] = out.str();
+        }
+        checkpointer->submit(std::move(texts), journal->lastSequence());
+        dirtySections = 0;
+    }
+
+    /**
+     * @brief Wait until started checkpoints are written (no-op if checkpointing is off).
+     * @throws std::runtime_error If the last checkpoint failed.
+     */
+    void waitForCheckpoint() {
+        if (checkpointer) checkpointer->wait();
+    }
+
+    /**
+     * @brief Drop the journaled operations that are not saved yet (no-op if journaling is off).
+     *
+     * Checkpoints already started are finished first; a checkpoint that fails
+     * is dropped too. The in-memory state is left as is, so call this only
+     * when closing without saving.
+     * @throws std::runtime_error If the journal cannot be rewritten.
+     */
+    void discardJournal() {
+        if (!journal) return;
+        try {
+            waitForCheckpoint();
+        } catch (const std::runtime_error&) {}
+        journal->reset(journal->getId());
+    }
+
+    /**
+     * @brief Wait until every journaled operation is on disk (no-op if journaling is off).
+     */
+    void syncJournal() {
+        if (journal) journal->flush();
+    }
+
+    /**
+     * @brief Render global state in the text file format.
+     */
+    std::string renderText() const {
+        std::ostringstream file;
+        for (int s = 0; s < Checkpointer::sectionCount; ++s) {
+            renderSection(static_cast<Checkpointer::Section>(s), file);
+        }
+        return file.str();
+    }
+
+    /**
+     * @brief Render one section of the text file format.
+     */
+    void renderSection(Checkpointer::Section section, std::ostream& file) const {
+        switch (section) {
+        case Checkpointer::Section::Vehicles:
+            file << vehicleOrder.size() << "\n"; // Number of vehicles
+            for (std::size_t slot : vehicleOrder) {
+                const Vehicle* v = vehicleAt(slot);
+                switch (v->getKind()) {
+                case Vehicle::VehicleKind::CombustionCar: {
+                    auto* p = static_cast<const CombustionCar*>(v);
+                    // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Doors
+                    file << "CombustionCar;" 
+                         << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
+                         << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
+                         << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
+                         << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
+                         << p->getDoors() << "\n";
+                    break;
+                }
+                case Vehicle::VehicleKind::ElectricCar: {
+                    auto* p = static_cast<const ElectricCar*>(v);
+                    // Type;Brand;Model;Reg;Cost;Battery;Licence;Mileage;Doors
+                    file << "ElectricCar;" 
+                         << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
+                         << p->getBaseCost() << ";" << p->getBatteryCapacity() << ";" 
+                         << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
+                         << p->getDoors() << "\n";
+                    break;
+                }
+                case Vehicle::VehicleKind::Truck: {
+                    auto* p = static_cast<const Truck*>(v);
+                    // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage;Capacity
+                    file << "Truck;" 
+                         << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
+                         << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
+                         << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
+                         << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << ";" 
+                         << p->getCargoCapacity() << "\n";
+                    break;
+                }
+                case Vehicle::VehicleKind::Motorcycle: {
+                    auto* p = static_cast<const Motorcycle*>(v);
+                    // Type;Brand;Model;Reg;Cost;Engine;FuelCons;FuelType;Licence;Mileage
+                    file << "Motorcycle;" 
+                         << p->getBrand() << ";" << p->getModel() << ";" << p->getRegNumber() << ";" 
+                         << p->getBaseCost() << ";" << p->getEngineSize() << ";" 
+                         << p->getFuelConsumption() << ";" << static_cast<int>(p->getFuelType()) << ";" 
+                         << static_cast<int>(p->getLicenceCategory()) << ";" << p->getMileage() << "\n";
+                    break;
+                }
+                }
+            }
+            break;
+
+        case Checkpointer::Section::Customers:
+            file << customerOrder.size() << "\n"; // Number of customers
+            for (std::size_t slot : customerOrder) {
+                const Customer* c = customerAt(slot);
+                if (c->getType() == CustomerType::Private) {
+                    auto* p = static_cast<const PrivateCustomer*>(c);
                     // PrivateCustomer;Name;Address;IDCard
-                    // parts[0];parts[1];parts[2];parts[3]
-                    if (parts.size() >= 4) {
-                         // Use parts[3] (IDCard) as ID
-                         c = new PrivateCustomer(parts[1], parts[2], parts[3]);
-                    }
-                } else if (parts[0] == "BusinessCustomer") {
+                    file << "PrivateCustomer;" << p->getName() << ";" 
+                         << p->getAddress() << ";" << p->getIdCardNumber() << "\n";
+                } else {
+                    auto* p = static_cast<const BusinessCustomer*>(c);
                     // BusinessCustomer;Name;Address;NIP
-                     if (parts.size() >= 4) {
-                        // Use parts[3] (NIP) as ID
-                        c = new BusinessCustomer(parts[1], parts[2], parts[3]);
-                     }
+                    file << "BusinessCustomer;" << p->getName() << ";" << p->getAddress() << ";" << p->getNip() << "\n";
+                }
+            }
+            break;
+
+        case Checkpointer::Section::Rentals:
+            file << rentals.size() << "\n"; // Number of rentals
+            for (const auto* r : rentals) {
+                file << r->getVehicle()->getRegNumber() << ";"
+                     << r->getCustomer()->getId() << ";"
+                     << r->getStartDate() << ";"
+                     << r->getEndDate() << "\n";
+            }
+            break;
+
+        case Checkpointer::Section::History:
+            if (historyLog) historyLog->renderIndex(file);
+            file << rentalHistory.size() << "\n";
+            for (const auto& record : rentalHistory.getRecords()) {
+                 file << rentalHistory.toText(record) << "\n";
+            }
+            break;
+
+        case Checkpointer::Section::Reservations:
+            file << reservations.size() << "\n";
+            for (std::size_t slot : vehicleOrder) {
+                for (const auto& b : reservations.bookingsOf(slot)) {
+                    file << vehicleAt(slot)->getRegNumber() << ";" << b.customerId << ";"
+                         << Date::toString(b.startDay) << ";" << Date::toString(b.endDay) << "\n";
                 }
+            }
+            break;
+
+        case Checkpointer::Section::Maintenance:
+            // intervals;oil;battery;inspection
+            file << "intervals";
+            for (int t = 0; t < MaintenanceSchedule::taskCount; ++t) {
+                file << ";" << maintenance.getInterval(static_cast<MaintenanceSchedule::Task>(t));
+            }
+            file << "\n";
+            forEachService([&](std::size_t count) { file << count << "\n"; },
+                           [&](std::size_t slot, MaintenanceSchedule::Task task, double mileage) {
+                file << vehicleAt(slot)->getRegNumber() << ";" << MaintenanceSchedule::taskName(task) << ";"
+                     << mileage << "\n";
+            });
+            break;
+        }
+    }
+
+    /**
+     * @brief Load global state from file.
+     *
+     * The vehicle and customer sections are split into chunks of lines that
+     * are parsed on a thread pool when they are large enough. The parsed
+     * objects are then added in file order, which rejects duplicate
+     * registration numbers and customer IDs exactly like a sequential load.
+     * Active rentals are linked after both sections are loaded.
+     * @param filename Path to file.
+     * @param threads Number of parser threads (0 = one per hardware thread).
+     */
+    void loadFromFile(const std::string& filename, std::size_t threads = 0) {
+        std::string buffer;
+        if (!FileIO::readAll(filename, buffer)) return;
+        loadFromText(buffer, threads);
+    }
+
+    /**
+     * @brief Load global state from a buffer in the text file format (see loadFromFile).
+     * @param buffer File contents.
+     * @param threads Number of parser threads (0 = one per hardware thread).
+     * @throws std::runtime_error If the buffer indexes sealed history segments but no history
+     *         log is open; the current state is left untouched.
+     */
+    void loadFromText(const std::string& buffer, std::size_t threads = 0) {
+        TextReader reader(buffer.data(), buffer.size());
+        std::string_view line; // current line, a view into buffer
+        std::array<std::string_view, 4> parts; // fields of the current line
+
+        // Collect the lines of a section announced by its count header
+        auto readSection = [&](std::vector<std::string_view>& lines) {
+            int count = 0;
+            if (reader.nextLine(line)) count = TextReader::toInt(line);
+            if (count <= 0) return;
+            lines.reserve(std::min(static_cast<std::size_t>(count), buffer.size()));
+            for (int i = 0; i < count && reader.nextLine(line); ++i) lines.push_back(line);
+        };
+        std::vector<std::string_view> vehicleLines;
+        std::vector<std::string_view> customerLines;
+        std::vector<std::string_view> rentalLines;
+        readSection(vehicleLines);
+        readSection(customerLines);
+        readSection(rentalLines);
+
+        // Check the history header before anything is cleared
+        bool hasLine = reader.nextLine(line);
+        bool sealed = hasLine && line.substr(0, 7) == "sealed ";
+        if (sealed && !historyLog) throw std::runtime_error("History log is not open.");
+
+        clearAll();
+
+        std::unique_ptr<ThreadPool> pool;
+        if (std::max(vehicleLines.size(), customerLines.size()) >= 2 * parallelChunkLines) {
+            if (threads == 0) threads = ThreadPool::defaultThreadCount();
+            if (threads > 1) pool = std::make_unique<ThreadPool>(threads);
+        }
+
+        // Load Vehicles
+        auto vehiclesParsed = parseSection<Vehicle>(vehicleLines, parseVehicleLine, pool.get());
+        reserveVehicles(vehicleLines.size());
+        for (std::size_t i = 0; i < vehiclesParsed.size(); ++i) {
+            auto& p = vehiclesParsed[i];
+            try {
+                if (!p.error.empty()) throw std::invalid_argument(p.error);
+                if (p.object) addVehicle(p.object); // rejects duplicate registration numbers
+            } catch (const std::exception& e) {
+                std::cout << "[Error Loading Vehicle]: " << e.what() << " Line: " << vehicleLines[i] << "\n";
+                delete p.object;
+            }
+        }
 
-                if (c) customers.push_back(c);
+        // Load Customers
+        auto customersParsed = parseSection<Customer>(customerLines, parseCustomerLine, pool.get());
+        pool.reset();
+        reserveCustomers(customerLines.size());
+        for (auto& p : customersParsed) {
+            try {
+                if (p.object) addCustomer(p.object); // rejects duplicate IDs
             } catch (...) {
-                if (c) delete c;
+                delete p.object;
             }
         }
 
         // Load Rentals
-        int rCount = 0;
-        if (std::getline(file, line)) rCount = std::stoi(line);
-
-        for (int i = 0; i < rCount; ++i) {
-            if (!std::getline(file, line)) break;
-            std::stringstream ss(line);
-            std::string segment;
-            std::vector<std::string> parts;
-            while (std::getline(ss, segment, ';')) parts.push_back(segment);
-
-            if (parts.size() < 4) continue;
-            
+        for (std::string_view rental : rentalLines) {
+            if (TextReader::split(rental, parts) < 4) continue;
+
             try {
-                rentVehicle(parts[0], parts[1], parts[2], parts[3], false);
+                rentVehicle(std::string(parts[0]), std::string(parts[1]),
+                            std::string(parts[2]), std::string(parts[3]), false);
             } catch (...) {}
         }
 
-        // Load History
+        // Load History (index of sealed segments if there are any, then the records in memory)
         int hCount = 0;
-        if (std::getline(file, line)) hCount = std::stoi(line);
-        rentalHistory.clear();
+        if (sealed) {
+            int sCount = TextReader::toInt(line.substr(7));
+            std::vector<HistoryLog::Segment> index;
+            for (int i = 0; i < sCount && reader.nextLine(line); ++i) {
+                index.push_back(HistoryLog::parseIndexLine(line));
+            }
+            historyLog->assign(std::move(index));
+            hasLine = reader.nextLine(line);
+        }
+        if (hasLine) hCount = TextReader::toInt(line);
+        if (hCount > 0) rentalHistory.reserve(std::min(static_cast<std::size_t>(hCount), buffer.size()));
         for (int i = 0; i < hCount; ++i) {
-             if (std::getline(file, line)) {
-                 rentalHistory.push_back(line);
+             if (reader.nextLine(line)) {
+                 addHistoryLine(line);
              }
         }
-        
-        file.close();
+
+        // Load Reservations (absent in older files)
+        int resCount = 0;
+        if (reader.nextLine(line)) resCount = TextReader::toInt(line);
+        for (int i = 0; i < resCount; ++i) {
+            if (!reader.nextLine(line)) break;
+            if (TextReader::split(line, parts) < 4) continue;
+
+            try {
+                reserveVehicle(std::string(parts[0]), std::string(parts[1]),
+                               std::string(parts[2]), std::string(parts[3]));
+            } catch (const std::invalid_argument&) {}
+        }
+
+        // Load Maintenance (absent in older files: every vehicle counts from its current mileage)
+        int serviceCount = 0;
+        hasLine = reader.nextLine(line);
+        if (hasLine && line.substr(0, 10) == "intervals;") {
+            std::size_t n = TextReader::split(line, parts);
+            for (std::size_t t = 1; t < n; ++t) {
+                try {
+                    loadServiceInterval(t - 1, TextReader::toDouble(parts[t]));
+                } catch (const std::invalid_argument&) {}
+            }
+            hasLine = reader.nextLine(line);
+        }
+        if (hasLine) serviceCount = TextReader::toInt(line);
+        for (int i = 0; i < serviceCount; ++i) {
+            if (!reader.nextLine(line)) break;
+            if (TextReader::split(line, parts) < 3) continue;
+
+            try {
+                loadService(parts[0], parts[1], TextReader::toDouble(parts[2]));
+            } catch (const std::invalid_argument&) {}
+        }
+    }
+
+    /**
+     * @brief Save global state to a binary snapshot (see Snapshot for the layout).
+     * Saving over the mapped snapshot builds its remaining objects and unmaps it first.
+     * @param filename Path to file.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void saveSnapshot(const std::string& filename) const {
+        if (mappedSnapshot && FileIO::sameFile(filename, mappedSnapshotFile)) releaseMappedSnapshot();
+        BinaryWriter out;
+        Snapshot::writeHeader(out);
+
+        // Records that were never built are copied unchanged
+        out.putU32(static_cast<std::uint32_t>(vehicleOrder.size()));
+        for (std::size_t slot : vehicleOrder) {
+            if (slots[slot]) {
+                Snapshot::writeVehicle(out, *slots[slot]);
+            } else {
+                out.putRecord(vehicleRecords[slot]);
+            }
+        }
+
+        out.putU32(static_cast<std::uint32_t>(customerOrder.size()));
+        for (std::size_t slot : customerOrder) {
+            if (customerSlots[slot]) {
+                Snapshot::writeCustomer(out, *customerSlots[slot]);
+            } else {
+                out.putRecord(customerRecords[slot]);
+            }
+        }
+
+        out.putU32(static_cast<std::uint32_t>(rentals.size()));
+        for (const auto* r : rentals) {
+            out.beginRecord();
+            out.putString(r->getVehicle()->getRegNumber());
+            out.putString(r->getCustomer()->getId());
+            out.putString(r->getStartDate());
+            out.putString(r->getEndDate());
+            out.endRecord();
+        }
+
+        // Snapshots are self-contained: sealed history is copied in
+        out.putU32(static_cast<std::uint32_t>(getHistorySize()));
+        forEachHistoryRecord([&](const RentalHistory& part, const HistoryRecord& record) {
+            out.putString(part.toText(record));
+        });
+
+        out.putU32(static_cast<std::uint32_t>(reservations.size()));
+        for (std::size_t slot : vehicleOrder) {
+            for (const auto& b : reservations.bookingsOf(slot)) {
+                out.beginRecord();
+                out.putString(vehicleAt(slot)->getRegNumber());
+                out.putString(b.customerId);
+                out.putString(Date::toString(b.startDay));
+                out.putString(Date::toString(b.endDay));
+                out.endRecord();
+            }
+        }
+
+        out.putU32(static_cast<std::uint32_t>(MaintenanceSchedule::taskCount));
+        for (int t = 0; t < MaintenanceSchedule::taskCount; ++t) {
+            out.putDouble(maintenance.getInterval(static_cast<MaintenanceSchedule::Task>(t)));
+        }
+        forEachService([&](std::size_t count) { out.putU32(static_cast<std::uint32_t>(count)); },
+                       [&](std::size_t slot, MaintenanceSchedule::Task task, double mileage) {
+            out.beginRecord();
+            out.putString(vehicleAt(slot)->getRegNumber());
+            out.putString(MaintenanceSchedule::taskName(task));
+            out.putDouble(mileage);
+            out.endRecord();
+        });
+
+        writeFileAtomically(filename, out.data());
+    }
+
+    /**
+     * @brief Load global state from a binary snapshot.
+     * Records that fail validation are skipped, like in loadFromFile. The file
+     * is loaded into a separate manager first, so the current state is kept
+     * if it turns out to be invalid.
+     * @param filename Path to file.
+     * @throws std::runtime_error If the file is not a valid snapshot.
+     */
+    void loadSnapshot(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return;
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        BinaryReader in(bytes.data(), bytes.size());
+        std::uint32_t fileVersion = Snapshot::readHeader(in);
+        VehicleManager loaded;
+
+        std::uint32_t vCount = in.getU32();
+        loaded.reserveVehicles(std::min<std::size_t>(vCount, in.remaining()));
+        for (std::uint32_t i = 0; i < vCount; ++i) {
+            BinaryReader record = in.getRecord();
+            Vehicle* v = nullptr;
+            try {
+                v = Snapshot::readVehicle(record);
+                loaded.addVehicle(v);
+            } catch (const std::invalid_argument& e) {
+                std::cout << "[Error Loading Vehicle]: " << e.what() << "\n";
+                delete v;
+            }
+        }
+
+        std::uint32_t cCount = in.getU32();
+        loaded.reserveCustomers(std::min<std::size_t>(cCount, in.remaining()));
+        for (std::uint32_t i = 0; i < cCount; ++i) {
+            BinaryReader record = in.getRecord();
+            Customer* c = nullptr;
+            try {
+                c = Snapshot::readCustomer(record);
+                loaded.addCustomer(c);
+            } catch (const std::invalid_argument&) {
+                delete c;
+            }
+        }
+
+        loaded.readSnapshotTail(in, fileVersion);
+        adoptState(loaded);
+    }
+
+    /**
+     * @brief Load global state from a memory-mapped binary snapshot.
+     *
+     * Only the fields used by the indexes (registration number, brand, numeric
+     * columns, customer ID and type) are decoded. Vehicle and customer objects
+     * are built from their mapped records the first time they are accessed,
+     * so start-up time does not depend on the size of the objects. The file
+     * stays mapped until the next load, destruction of the manager or a
+     * snapshot saved over it. The summary decoders check every field the way
+     * the constructors do, so records that fail validation are skipped like
+     * in loadSnapshot and building an object later cannot fail. As in
+     * loadSnapshot, the current state is kept if the file is invalid.
+     * @param filename Path to file.
+     * @throws std::runtime_error If the file is not a valid snapshot.
+     */
+    void mapSnapshot(const std::string& filename) {
+        auto mapped = std::make_unique<MappedFile>();
+        if (!mapped->open(filename)) return;
+
+        BinaryReader in(mapped->data(), mapped->size());
+        std::uint32_t fileVersion = Snapshot::readHeader(in);
+        VehicleManager loaded;
+        loaded.mappedSnapshot = std::move(mapped);
+        loaded.mappedSnapshotFile = filename;
+
+        std::uint32_t vCount = in.getU32();
+        loaded.reserveVehicles(std::min<std::size_t>(vCount, in.remaining()));
+        for (std::uint32_t i = 0; i < vCount; ++i) {
+            std::string_view record = in.getRecordBytes();
+            Snapshot::VehicleSummary summary;
+            try {
+                summary = Snapshot::readVehicleSummary(BinaryReader(record.data(), record.size()));
+            } catch (const std::invalid_argument& e) {
+                std::cout << "[Error Loading Vehicle]: " << e.what() << "\n";
+                continue;
+            }
+            if (!loaded.isRegNumberUnique(summary.regNumber)) {
+                std::cout << "[Error Loading Vehicle]: Vehicle with this registration number already exists.\n";
+                continue;
+            }
+            std::size_t slot = loaded.reserveSlot();
+            loaded.vehicleRecords[slot] = record;
+            loaded.indexSlot(slot, summary.regNumber, summary.brand, summary.row);
+        }
+
+        std::uint32_t cCount = in.getU32();
+        loaded.reserveCustomers(std::min<std::size_t>(cCount, in.remaining()));
+        for (std::uint32_t i = 0; i < cCount; ++i) {
+            std::string_view record = in.getRecordBytes();
+            Snapshot::CustomerSummary summary;
+            try {
+                summary = Snapshot::readCustomerSummary(BinaryReader(record.data(), record.size()));
+            } catch (const std::invalid_argument&) {
+                continue;
+            }
+            if (!loaded.isCustomerIdUnique(summary.id)) continue;
+            std::size_t slot = loaded.reserveCustomerSlot();
+            loaded.customerRecords[slot] = record;
+            loaded.indexCustomerSlot(slot, summary.id, summary.type);
+        }
+
+        loaded.readSnapshotTail(in, fileVersion);
+        adoptState(loaded);
+    }
+
+    /**
+     * @brief Convert a text data file (loadFromFile format) into a binary snapshot.
+     * @param textFile Path of the existing text file.
+     * @param snapshotFile Path of the snapshot to write.
+     */
+    static void convertTextToSnapshot(const std::string& textFile, const std::string& snapshotFile) {
+        VehicleManager manager;
+        manager.loadFromFile(textFile);
+        manager.saveSnapshot(snapshotFile);
     }
 };
 
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Vehicle.hpp"
+#include "CombustionVehicle.hpp"
+#include "FleetColumns.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+
+namespace bk {
+
+/**
+ * @class VehicleQuery
+ * @brief Builder for multi-criteria vehicle searches run by VehicleManager::forEachVehicle.
+ *
+ * All criteria must hold. Results are produced in the order of the index the
+ * manager picks, so offset/limit paging is stable as long as the fleet does
+ * not change between calls.
+ */
+class VehicleQuery {
+public:
+    static constexpr std::size_t noLimit = std::numeric_limits<std::size_t>::max();
+    static constexpr std::uint8_t allKinds = (1u << Vehicle::kindCount) - 1;
+
+private:
+    std::optional<std::string> brand;               ///< Exact brand
+    std::optional<std::string> model;               ///< Exact model
+    std::uint8_t kinds = allKinds;                  ///< Bit per accepted VehicleKind
+    std::optional<CombustionVehicle::FuelType> fuel; ///< Fuel type (combustion only)
+    std::optional<Vehicle::LicenceCategory> licence; ///< Required licence category
+    double minCost = -std::numeric_limits<double>::infinity();
+    double maxCost = std::numeric_limits<double>::infinity();
+    double minMileage = -std::numeric_limits<double>::infinity();
+    double maxMileage = std::numeric_limits<double>::infinity();
+    bool onlyAvailable = false;   ///< Skip rented vehicles
+    std::size_t skipCount = 0;    ///< Matches to skip before the first result
+    std::size_t maxResults = noLimit; ///< Maximum number of results
+
+    static std::uint8_t kindBit(Vehicle::VehicleKind k) {
+        return static_cast<std::uint8_t>(1u << static_cast<int>(k));
+    }
+
+public:
+    VehicleQuery& withBrand(const std::string& value) { brand = value; return *this; }
+    VehicleQuery& withModel(const std::string& value) { model = value; return *this; }
+
+    /**
+     * @brief Accept only the given concrete kind.
+     */
+    VehicleQuery& ofKind(Vehicle::VehicleKind k) {
+        kinds &= kindBit(k);
+        return *this;
+    }
+
+    /**
+     * @brief Accept only vehicles of the given main type.
+     */
+    VehicleQuery& ofType(Vehicle::MainVehicleType type) {
+        switch (type) {
+            case Vehicle::MainVehicleType::Car:
+                kinds &= kindBit(Vehicle::VehicleKind::CombustionCar) | kindBit(Vehicle::VehicleKind::ElectricCar);
+                break;
+            case Vehicle::MainVehicleType::Truck:
+                kinds &= kindBit(Vehicle::VehicleKind::Truck);
+                break;
+            case Vehicle::MainVehicleType::Motorcycle:
+                kinds &= kindBit(Vehicle::VehicleKind::Motorcycle);
+                break;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Accept only combustion vehicles using the given fuel.
+     */
+    VehicleQuery& withFuelType(CombustionVehicle::FuelType type) {
+        fuel = type;
+        kinds &= static_cast<std::uint8_t>(~kindBit(Vehicle::VehicleKind::ElectricCar));
+        return *this;
+    }
+
+    VehicleQuery& withLicence(Vehicle::LicenceCategory cat) { licence = cat; return *this; }
+
+    /**
+     * @brief Accept base cost in [min, max].
+     */
+    VehicleQuery& priceBetween(double min, double max) {
+        minCost = min;
+        maxCost = max;
+        return *this;
+    }
+
+    /**
+     * @brief Accept mileage in [min, max].
+     */
+    VehicleQuery& mileageBetween(double min, double max) {
+        minMileage = min;
+        maxMileage = max;
+        return *this;
+    }
+
+    VehicleQuery& availableOnly() { onlyAvailable = true; return *this; }
+    VehicleQuery& offset(std::size_t n) { skipCount = n; return *this; }
+    VehicleQuery& limit(std::size_t n) { maxResults = n; return *this; }
+
+    // Getters used to plan the search
+    const std::optional<std::string>& getBrand() const { return brand; }
+    std::uint8_t getKindMask() const { return kinds; }
+    bool isAvailableOnly() const { return onlyAvailable; }
+    std::size_t getOffset() const { return skipCount; }
+    std::size_t getLimit() const { return maxResults; }
+
+    /**
+     * @brief Check the criteria answered by the fleet columns.
+     * @param cols Fleet columns.
+     * @param row Slot ID of the vehicle.
+     * @param available True if the vehicle is not rented.
+     */
+    bool matchesColumns(const FleetColumns& cols, std::size_t row, bool available) const {
+        if (onlyAvailable && !available) return false;
+        if (!((kinds >> cols.getKinds()[row]) & 1u)) return false;
+
+        double cost = cols.getBaseCosts()[row];
+        if (cost < minCost || cost > maxCost) return false;
+        double miles = cols.getMileages()[row];
+        if (miles < minMileage || miles > maxMileage) return false;
+
+        if (licence && cols.getLicences()[row] != static_cast<std::uint8_t>(*licence)) return false;
+        if (fuel && cols.getFuelTypes()[row] != static_cast<std::uint8_t>(*fuel)) return false;
+        return true;
+    }
+
+    /**
+     * @brief Check the criteria that need the vehicle object (brand and model).
+     */
+    bool matchesObject(const Vehicle& v) const {
+        if (brand && v.getBrand() != *brand) return false;
+        if (model && v.getModel() != *model) return false;
+        return true;
+    }
+
+    /**
+     * @brief Check a single vehicle against all criteria.
+     * @param cols Fleet columns.
+     * @param row Slot ID of the vehicle.
+     * @param v The vehicle in that slot.
+     * @param available True if the vehicle is not rented.
+     */
+    bool matches(const FleetColumns& cols, std::size_t row, const Vehicle& v, bool available) const {
+        return matchesColumns(cols, row, available) && matchesObject(v);
+    }
+};
+
+} // namespace bk
@@ -9,7 +9,11 @@ int main() {
     
     // Auto-load data
     std::cout << "Loading data...\n";
-    vm.loadFromFile("data.txt");
+    // Completed rentals beyond the in-memory tail live in data.history.<n> segments
+    vm.openHistoryLog("data.history");
+    // Last checkpoint plus the journaled changes made after it. data.txt is an import source:
+    // it seeds the first run and is never written; saved state lives in data.ckpt and its segments.
+    vm.openCheckpoint("data.ckpt", "data.journal", "data.txt");
     std::cout << "Data loaded.\n";
 
     // Run UI